@@ -4,13 +4,26 @@
 
 #include <gensokyo/helper/bitflags.hpp>
 #include <gensokyo/helper/cpu.hpp>
+#include <gensokyo/helper/mapped_file.hpp>
 #include <gensokyo/helper/simd.hpp>
+#include <gensokyo/helper/thread_pool.hpp>
 
 #include <gensokyo/memory/address.hpp>
+#include <gensokyo/memory/cached_process.hpp>
+#include <gensokyo/memory/freezer.hpp>
+#include <gensokyo/memory/local_process.hpp>
 #include <gensokyo/memory/memory.hpp>
+#include <gensokyo/memory/memory_watch.hpp>
 #include <gensokyo/memory/module.hpp>
 #include <gensokyo/memory/pattern.hpp>
+#include <gensokyo/memory/pointer_resolver.hpp>
+#include <gensokyo/memory/pointer_scanner.hpp>
 #include <gensokyo/memory/process.hpp>
+#include <gensokyo/memory/remote_ptr.hpp>
+#include <gensokyo/memory/signature_cache.hpp>
+#include <gensokyo/memory/soft_dirty.hpp>
+#include <gensokyo/memory/value_scanner.hpp>
+#include <gensokyo/memory/write_queue.hpp>
 #if defined(WINDOWS)
     #include <gensokyo/memory/windows/win_process.hpp>
 #elif defined(LINUX)
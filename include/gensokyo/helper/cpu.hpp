@@ -14,7 +14,8 @@ namespace gensokyo
     {
         NONE,
         SSE,
-        AVX2
+        AVX2,
+        AVX512
     };
 
     namespace impl
@@ -58,7 +59,12 @@ namespace gensokyo
                     f_7_ECX_ = data_[7][2];
                 }
 
-                if (f_1_ECX_[28] && f_7_EBX_[5])
+                // AVX512F and AVX512BW, the byte compares need BW
+                if (f_7_EBX_[16] && f_7_EBX_[30])
+                {
+                    _arch = CPUArch::AVX512;
+                }
+                else if (f_1_ECX_[28] && f_7_EBX_[5])
                 {
                     _arch = CPUArch::AVX2;
                 }
@@ -67,7 +73,9 @@ namespace gensokyo
                     _arch = CPUArch::SSE;
                 }
 #elif defined(CLANG) || defined(GCC)
-                if (__builtin_cpu_supports("avx2"))
+                if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+                    _arch = CPUArch::AVX512;
+                else if (__builtin_cpu_supports("avx2"))
                     _arch = CPUArch::AVX2;
                 else if (__builtin_cpu_supports("sse2"))
                     _arch = CPUArch::SSE;
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <utility>
+
+namespace gensokyo::impl
+{
+    // A file mapped read/write and shared, so writes land in the file without explicit saving
+    class MappedFile
+    {
+        std::intptr_t _file { -1 };
+        void* _mapping {};
+        std::uint8_t* _data {};
+        std::size_t _size {};
+
+        void map(std::size_t size);
+        void unmap() noexcept;
+        void close() noexcept;
+
+      public:
+        MappedFile() = default;
+
+        // opens or creates the file, it grows to at least min_size bytes, new bytes are zero
+        MappedFile(const std::filesystem::path& path, std::size_t min_size);
+
+        MappedFile(const MappedFile&)            = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& other) noexcept
+         : _file(std::exchange(other._file, -1)),
+           _mapping(std::exchange(other._mapping, nullptr)),
+           _data(std::exchange(other._data, nullptr)),
+           _size(std::exchange(other._size, 0))
+        {
+        }
+
+        MappedFile& operator=(MappedFile&& other) noexcept
+        {
+            if (this != &other)
+            {
+                close();
+                _file    = std::exchange(other._file, -1);
+                _mapping = std::exchange(other._mapping, nullptr);
+                _data    = std::exchange(other._data, nullptr);
+                _size    = std::exchange(other._size, 0);
+            }
+
+            return *this;
+        }
+
+        ~MappedFile()
+        {
+            close();
+        }
+
+        // change the file size and remap it, pointers into the old mapping are invalid afterwards
+        void resize(std::size_t size);
+
+        [[nodiscard]] bool is_open() const noexcept
+        {
+            return _data != nullptr;
+        }
+
+        [[nodiscard]] std::uint8_t* data() const noexcept
+        {
+            return _data;
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            return _size;
+        }
+    };
+}
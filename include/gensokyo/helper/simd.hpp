@@ -1,8 +1,14 @@
 #pragma once
+#include <cstdint>
 #include <emmintrin.h>
 #include <immintrin.h>
 #include <type_traits>
 
+// AVX-512 intrinsics only compile when the compiler targets it, MSVC accepts them everywhere
+#if defined(MSVC) || defined(__AVX512BW__)
+    #define GENSOKYO_SIMD_AVX512
+#endif
+
 namespace gensokyo::simd
 {
 #if defined(GCC)
@@ -29,13 +35,24 @@ namespace gensokyo::simd
             using type = __m256i;
         };
 
+#if defined(GENSOKYO_SIMD_AVX512)
+        template <>
+        struct simd_wrapper<__m512i>
+        {
+            using type = __m512i;
+        };
+#endif
+
         template <typename T>
         class simd
         {
             using simd_type = typename T::type;
 
           public:
-            static constexpr int simd_length = std::is_same_v<simd_type, __m128i> ? 16 : 32;
+            static constexpr int simd_length = sizeof(simd_type);
+
+            // one bit per byte, AVX-512 compares straight into a 64-bit mask register
+            using mask_type = std::conditional_t<simd_length == 64, std::uint64_t, std::uint32_t>;
 
             template <typename U>
             static simd_type* cast(const U* data)
@@ -54,6 +71,12 @@ namespace gensokyo::simd
                 {
                     return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
                 }
+#if defined(GENSOKYO_SIMD_AVX512)
+                else if constexpr (std::is_same_v<simd_type, __m512i>)
+                {
+                    return _mm512_loadu_si512(data);
+                }
+#endif
             }
 
             template <typename U>
@@ -67,6 +90,70 @@ namespace gensokyo::simd
                 {
                     return _mm256_load_si256(reinterpret_cast<const __m256i*>(data));
                 }
+#if defined(GENSOKYO_SIMD_AVX512)
+                else if constexpr (std::is_same_v<simd_type, __m512i>)
+                {
+                    return _mm512_load_si512(data);
+                }
+#endif
+            }
+
+            // load 16 bytes and repeat them in every 128-bit lane, shuffle_epi8 works per lane
+            template <typename U>
+            static simd_type broadcast_si128(const U* data)
+            {
+                if constexpr (std::is_same_v<simd_type, __m128i>)
+                {
+                    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+                }
+                else if constexpr (std::is_same_v<simd_type, __m256i>)
+                {
+                    return _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)));
+                }
+#if defined(GENSOKYO_SIMD_AVX512)
+                else if constexpr (std::is_same_v<simd_type, __m512i>)
+                {
+                    // the zero masked form, gcc warns about the undefined source of the unmasked one
+                    return _mm512_maskz_broadcast_i32x4(static_cast<__mmask16>(0xFFFF), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)));
+                }
+#endif
+            }
+
+            template <typename U>
+            static void store_unaligned(U* data, simd_type a)
+            {
+                if constexpr (std::is_same_v<simd_type, __m128i>)
+                {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(data), a);
+                }
+                else if constexpr (std::is_same_v<simd_type, __m256i>)
+                {
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(data), a);
+                }
+#if defined(GENSOKYO_SIMD_AVX512)
+                else if constexpr (std::is_same_v<simd_type, __m512i>)
+                {
+                    _mm512_storeu_si512(data, a);
+                }
+#endif
+            }
+
+            static simd_type setzero()
+            {
+                if constexpr (std::is_same_v<simd_type, __m128i>)
+                {
+                    return _mm_setzero_si128();
+                }
+                else if constexpr (std::is_same_v<simd_type, __m256i>)
+                {
+                    return _mm256_setzero_si256();
+                }
+#if defined(GENSOKYO_SIMD_AVX512)
+                else if constexpr (std::is_same_v<simd_type, __m512i>)
+                {
+                    return _mm512_setzero_si512();
+                }
+#endif
             }
 
             static simd_type cmpeq_epi8(simd_type a, simd_type b)
@@ -79,17 +166,44 @@ namespace gensokyo::simd
                 {
                     return _mm256_cmpeq_epi8(a, b);
                 }
+#if defined(GENSOKYO_SIMD_AVX512)
+                else if constexpr (std::is_same_v<simd_type, __m512i>)
+                {
+                    return _mm512_movm_epi8(_mm512_cmpeq_epi8_mask(a, b));
+                }
+#endif
             }
 
-            static int movemask_epi8(simd_type a)
+            static mask_type movemask_epi8(simd_type a)
             {
                 if constexpr (std::is_same_v<simd_type, __m128i>)
                 {
-                    return _mm_movemask_epi8(a);
+                    return static_cast<mask_type>(_mm_movemask_epi8(a));
                 }
                 else if constexpr (std::is_same_v<simd_type, __m256i>)
                 {
-                    return _mm256_movemask_epi8(a);
+                    return static_cast<mask_type>(_mm256_movemask_epi8(a));
+                }
+#if defined(GENSOKYO_SIMD_AVX512)
+                else if constexpr (std::is_same_v<simd_type, __m512i>)
+                {
+                    return _mm512_movepi8_mask(a);
+                }
+#endif
+            }
+
+            // bit i is set when byte i of a and b are equal, same as movemask_epi8(cmpeq_epi8(a, b))
+            static mask_type cmpeq_mask(simd_type a, simd_type b)
+            {
+#if defined(GENSOKYO_SIMD_AVX512)
+                if constexpr (std::is_same_v<simd_type, __m512i>)
+                {
+                    return _mm512_cmpeq_epi8_mask(a, b);
+                }
+                else
+#endif
+                {
+                    return movemask_epi8(cmpeq_epi8(a, b));
                 }
             }
 
@@ -103,6 +217,12 @@ namespace gensokyo::simd
                 {
                     return _mm256_set1_epi8(static_cast<int8_t>(value));
                 }
+#if defined(GENSOKYO_SIMD_AVX512)
+                else if constexpr (std::is_same_v<simd_type, __m512i>)
+                {
+                    return _mm512_set1_epi8(static_cast<char>(value));
+                }
+#endif
             }
 
             static simd_type and_si(simd_type a, simd_type b)
@@ -115,6 +235,68 @@ namespace gensokyo::simd
                 {
                     return _mm256_and_si256(a, b);
                 }
+#if defined(GENSOKYO_SIMD_AVX512)
+                else if constexpr (std::is_same_v<simd_type, __m512i>)
+                {
+                    return _mm512_and_si512(a, b);
+                }
+#endif
+            }
+
+            static simd_type xor_si(simd_type a, simd_type b)
+            {
+                if constexpr (std::is_same_v<simd_type, __m128i>)
+                {
+                    return _mm_xor_si128(a, b);
+                }
+                else if constexpr (std::is_same_v<simd_type, __m256i>)
+                {
+                    return _mm256_xor_si256(a, b);
+                }
+#if defined(GENSOKYO_SIMD_AVX512)
+                else if constexpr (std::is_same_v<simd_type, __m512i>)
+                {
+                    return _mm512_xor_si512(a, b);
+                }
+#endif
+            }
+
+            // use each byte of b (low 4 bits) as an index into the 16 bytes of a
+            static simd_type shuffle_epi8(simd_type a, simd_type b)
+            {
+                if constexpr (std::is_same_v<simd_type, __m128i>)
+                {
+                    return _mm_shuffle_epi8(a, b);
+                }
+                else if constexpr (std::is_same_v<simd_type, __m256i>)
+                {
+                    return _mm256_shuffle_epi8(a, b);
+                }
+#if defined(GENSOKYO_SIMD_AVX512)
+                else if constexpr (std::is_same_v<simd_type, __m512i>)
+                {
+                    return _mm512_shuffle_epi8(a, b);
+                }
+#endif
+            }
+
+            template <int Count>
+            static simd_type srli_epi16(simd_type a)
+            {
+                if constexpr (std::is_same_v<simd_type, __m128i>)
+                {
+                    return _mm_srli_epi16(a, Count);
+                }
+                else if constexpr (std::is_same_v<simd_type, __m256i>)
+                {
+                    return _mm256_srli_epi16(a, Count);
+                }
+#if defined(GENSOKYO_SIMD_AVX512)
+                else if constexpr (std::is_same_v<simd_type, __m512i>)
+                {
+                    return _mm512_srli_epi16(a, Count);
+                }
+#endif
             }
 
             static int test(simd_type a, simd_type b)
@@ -127,12 +309,41 @@ namespace gensokyo::simd
                 {
                     return _mm256_testc_si256(a, b);
                 }
+#if defined(GENSOKYO_SIMD_AVX512)
+                else if constexpr (std::is_same_v<simd_type, __m512i>)
+                {
+                    const auto not_a_and_b = _mm512_andnot_si512(a, b);
+                    return _mm512_test_epi64_mask(not_a_and_b, not_a_and_b) == 0;
+                }
+#endif
+            }
+
+            // true when a and b are equal in every bit that is set in masks
+            static bool equal_masked(simd_type a, simd_type b, simd_type masks)
+            {
+                if constexpr (std::is_same_v<simd_type, __m128i>)
+                {
+                    return _mm_testz_si128(_mm_xor_si128(a, b), masks);
+                }
+                else if constexpr (std::is_same_v<simd_type, __m256i>)
+                {
+                    return _mm256_testz_si256(_mm256_xor_si256(a, b), masks);
+                }
+#if defined(GENSOKYO_SIMD_AVX512)
+                else if constexpr (std::is_same_v<simd_type, __m512i>)
+                {
+                    return _mm512_test_epi8_mask(_mm512_xor_si512(a, b), masks) == 0;
+                }
+#endif
             }
         };
     }
 
     using iSSE  = impl::simd<impl::simd_wrapper<__m128i>>;
     using iAVX2 = impl::simd<impl::simd_wrapper<__m256i>>;
+#if defined(GENSOKYO_SIMD_AVX512)
+    using iAVX512 = impl::simd<impl::simd_wrapper<__m512i>>;
+#endif
 #if defined(GCC)
     #pragma GCC diagnostic pop
 #elif defined(CLANG)
@@ -0,0 +1,187 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace gensokyo
+{
+    namespace impl
+    {
+        class ThreadPool
+        {
+            std::vector<std::jthread> _workers {};
+            std::deque<std::move_only_function<void()>> _tasks {};
+            std::mutex _mutex {};
+            std::condition_variable _cv {};
+            std::once_flag _started {};
+            bool _stopping {};
+
+            // workers are only created on first use, so including the library doesn't spawn threads
+            void start()
+            {
+                std::call_once(_started,
+                               [this]
+                               {
+                                   const auto count = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+                                   for (std::size_t i = 0; i < count; i++)
+                                   {
+                                       _workers.emplace_back(
+                                         [this]
+                                         {
+                                             work();
+                                         });
+                                   }
+                               });
+            }
+
+            void work()
+            {
+                while (true)
+                {
+                    std::move_only_function<void()> task {};
+                    {
+                        std::unique_lock lock(_mutex);
+                        _cv.wait(lock,
+                                 [this]
+                                 {
+                                     return _stopping || !_tasks.empty();
+                                 });
+
+                        if (_tasks.empty())
+                            return;
+
+                        task = std::move(_tasks.front());
+                        _tasks.pop_front();
+                    }
+
+                    task();
+                }
+            }
+
+            void push(std::move_only_function<void()> task)
+            {
+                start();
+                {
+                    std::lock_guard lock(_mutex);
+                    _tasks.push_back(std::move(task));
+                }
+                _cv.notify_one();
+            }
+
+          public:
+            ThreadPool()                             = default;
+            ThreadPool(const ThreadPool&)            = delete;
+            ThreadPool(ThreadPool&&)                 = delete;
+            ThreadPool& operator=(const ThreadPool&) = delete;
+            ThreadPool& operator=(ThreadPool&&)      = delete;
+
+            ~ThreadPool()
+            {
+                {
+                    std::lock_guard lock(_mutex);
+                    _stopping = true;
+                }
+                _cv.notify_all();
+
+                // join before the mutex and condition variable go away
+                _workers.clear();
+            }
+
+            // number of worker threads, the thread calling parallel_for works too
+            std::size_t size()
+            {
+                start();
+                return _workers.size();
+            }
+
+            template <typename F>
+            std::future<std::invoke_result_t<F>> submit(F&& func)
+            {
+                std::packaged_task<std::invoke_result_t<F>()> task(std::forward<F>(func));
+                auto future = task.get_future();
+                push(std::move(task));
+                return future;
+            }
+
+            /*
+             * Call func(i) for every i in [0, count) and return after all of them are done
+             * The calling thread takes indices too, so nested calls from a worker can't deadlock
+             * When func throws no more indices are handed out, the first exception is rethrown here once every call has returned
+             */
+            template <typename F>
+            void parallel_for(std::size_t count, F&& func)
+            {
+                if (count == 0)
+                    return;
+
+                struct State
+                {
+                    std::atomic<std::size_t> next {};
+                    std::atomic<std::size_t> active {};
+                    std::mutex mutex {};
+                    std::condition_variable cv {};
+                    std::exception_ptr error {};
+                };
+
+                auto state = std::make_shared<State>();
+
+                const auto run = [state, count, &func]
+                {
+                    try
+                    {
+                        for (std::size_t index; (index = state->next++) < count;)
+                            func(index);
+                    }
+                    catch (...)
+                    {
+                        state->next = count;
+
+                        std::lock_guard lock(state->mutex);
+                        if (!state->error)
+                            state->error = std::current_exception();
+                    }
+                };
+
+                // a helper that starts after everything is taken never touches func, so it may outlive this call
+                for (std::size_t i = 1, helpers = std::min(count, size() + 1); i < helpers; i++)
+                {
+                    push(
+                      [state, run]
+                      {
+                          state->active++;
+                          run();
+
+                          if (--state->active == 0)
+                          {
+                              std::lock_guard lock(state->mutex);
+                              state->cv.notify_all();
+                          }
+                      });
+                }
+
+                run();
+
+                std::unique_lock lock(state->mutex);
+                state->cv.wait(lock,
+                               [&]
+                               {
+                                   return state->active == 0;
+                               });
+
+                if (state->error)
+                    std::rethrow_exception(state->error);
+            }
+        };
+    }
+
+    inline impl::ThreadPool thread_pool {};
+}
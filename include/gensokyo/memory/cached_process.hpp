@@ -0,0 +1,120 @@
+#pragma once
+
+#include "process.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace gensokyo
+{
+    /*
+     * Reads through another process a whole page at a time and serves later reads of the same page from memory
+     * Pages go stale when invalidate() bumps the generation or when they are older than max_age, writes go through and update cached pages
+     * Safe to use from several threads, the wrapped process has to outlive this
+     */
+    class CachedProcess : public impl::Process
+    {
+      public:
+        static constexpr std::size_t page_size = 0x1000;
+
+        struct Stats
+        {
+            std::uint64_t hits {};
+            std::uint64_t misses {};
+        };
+
+      private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Page
+        {
+            std::array<std::uint8_t, page_size> data {};
+            std::uint64_t generation {};
+            Clock::time_point fetched {};
+
+            // when it was last read, hits only hold the shared lock
+            std::atomic<std::uint64_t> used {};
+        };
+
+        impl::Process& _process;
+        Clock::duration _max_age {};
+        std::size_t _max_pages {};
+
+        std::unordered_map<std::uintptr_t, Page> _pages {};
+        mutable std::shared_mutex _mutex {};
+
+        std::atomic<std::uint64_t> _generation {};
+        std::atomic<std::uint64_t> _uses {};
+        std::atomic<std::uint64_t> _hits {};
+        std::atomic<std::uint64_t> _misses {};
+
+        [[nodiscard]] bool is_fresh(const Page& page, Clock::time_point now) const noexcept;
+
+        // copy from a cached page, false when it's missing or stale
+        bool copy_cached(std::uintptr_t page, std::size_t offset, void* buffer, std::size_t size, Clock::time_point now);
+        void insert(std::uintptr_t page, const std::uint8_t* data, std::uint64_t generation, Clock::time_point fetched);
+
+        void touch(Page& page) noexcept
+        {
+            page.used.store(_uses.fetch_add(1, std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+
+        // serve a read page by page, fetching the pages that aren't cached, count_stats is off when the caller already counted them
+        bool read_pages(std::uintptr_t address, std::uint8_t* buffer, std::size_t size, bool count_stats);
+
+      public:
+        /*
+         * @param max_age Pages older than this are read again, zero keeps them until the next invalidate()
+         * @param max_pages Stale pages are dropped when the cache grows past this, then the least recently used ones
+         */
+        explicit CachedProcess(impl::Process& process, Clock::duration max_age = {}, std::size_t max_pages = 4096);
+
+        CachedProcess(const CachedProcess&)            = delete;
+        CachedProcess& operator=(const CachedProcess&) = delete;
+
+        // everything cached so far is read again on next use, e.g once per frame
+        void invalidate() noexcept
+        {
+            _generation.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] std::uint64_t generation() const noexcept
+        {
+            return _generation.load(std::memory_order_relaxed);
+        }
+
+        // one hit or miss per page touched by a read
+        [[nodiscard]] Stats stats() const noexcept
+        {
+            return { _hits.load(std::memory_order_relaxed), _misses.load(std::memory_order_relaxed) };
+        }
+
+        void reset_stats() noexcept
+        {
+            _hits   = 0;
+            _misses = 0;
+        }
+
+        std::uint32_t get_pid() override
+        {
+            return _process.get_pid();
+        }
+
+        bool attached() override
+        {
+            return _process.attached();
+        }
+
+      protected:
+        void enumerate_regions(const RegionCallbackFn& func) override
+        {
+            _process.for_each_region({}, func);
+        }
+
+        bool read_impl(std::uintptr_t address, void* buffer, std::size_t size) override;
+        void read_many_impl(std::span<impl::ReadRequest> requests) override;
+        bool write_impl(std::uintptr_t address, void* buffer, std::size_t size) override;
+    };
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "process.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace gensokyo
+{
+    /*
+     * Holds values fixed in another process by writing them again every interval from a thread of its own
+     * Every round is one write_many of all frozen values, on linux one process_vm_writev no matter how many there are
+     * The thread starts with the first freeze() and sleeps while nothing is frozen, the process has to outlive this
+     */
+    class Freezer
+    {
+      public:
+        using Clock = std::chrono::steady_clock;
+
+      private:
+        struct Frozen
+        {
+            std::size_t id {};
+            std::uintptr_t address {};
+            std::vector<std::uint8_t> value {};
+        };
+
+        impl::Process& _process;
+        std::vector<Frozen> _frozen {};
+
+        // built again only after the frozen values change
+        std::vector<impl::WriteRequest> _requests {};
+        bool _changed {};
+
+        Clock::duration _interval {};
+        bool _reschedule {};
+        std::size_t _next_id {};
+        std::atomic<std::uint64_t> _rounds {};
+
+        std::mutex _mutex {};
+        std::condition_variable_any _cv {};
+        std::once_flag _started {};
+
+        // last, so it's stopped and joined before anything it uses goes away
+        std::jthread _thread {};
+
+        void run(std::stop_token token);
+
+        // write everything once with _mutex held
+        std::size_t apply_locked();
+
+      public:
+        explicit Freezer(impl::Process& process, Clock::duration interval = std::chrono::milliseconds(10));
+
+        Freezer(const Freezer&)            = delete;
+        Freezer& operator=(const Freezer&) = delete;
+
+        // returns an id for unfreeze(), a value frozen at the same address again replaces the old one
+        std::size_t freeze(std::uintptr_t address, const void* buffer, std::size_t size);
+
+        template <typename T>
+        std::size_t freeze(std::uintptr_t address, const T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "only plain values can be frozen");
+            return freeze(address, &value, sizeof(T));
+        }
+
+        bool unfreeze(std::size_t id);
+        void clear();
+
+        [[nodiscard]] std::size_t size();
+
+        void set_interval(Clock::duration interval);
+
+        // write every frozen value now instead of waiting for the thread, returns how many succeeded
+        std::size_t apply();
+
+        // rounds written by the thread so far
+        [[nodiscard]] std::uint64_t rounds() const noexcept
+        {
+            return _rounds.load(std::memory_order_relaxed);
+        }
+    };
+}
@@ -1,11 +1,74 @@
 #pragma once
 
 #include "../process.hpp"
+#include <mutex>
 
 namespace gensokyo
 {
-    class LinuxProcess : impl::Process
+    class LinuxProcess : public impl::Process
     {
-    };
+      public:
+        enum class AccessMethod
+        {
+            None,
+            // process_vm_readv / process_vm_writev, one syscall per transfer without touching a file
+            VmReadv,
+            // pread / pwrite on /proc/<pid>/mem, for kernels or sandboxes without the above
+            ProcMem,
+        };
+
+      private:
+        std::uint32_t _pid {};
+        int _mem {-1};
+        AccessMethod _method {};
+        std::once_flag _mem_opened {};
+
+        void attach(std::uint32_t pid);
+
+        /*
+         * Write through /proc/<pid>/mem, opened on first use when attached with VmReadv
+         * process_vm_writev fails on read-only pages like code, the file forces the write the way a debugger does
+         */
+        bool write_mem(std::uintptr_t address, void* buffer, std::size_t size);
+
+      public:
+        /*
+         * @param process_name Name of the executable, like "bash", matched against /proc/<pid>/comm and the file name of /proc/<pid>/exe
+         *
+         * Will throw an runtime_error exception when it fails to attach to process
+         */
+        explicit LinuxProcess(std::string_view process_name);
+        explicit LinuxProcess(std::uint32_t pid);
+        ~LinuxProcess() override;
+
+        LinuxProcess(const LinuxProcess&)            = delete;
+        LinuxProcess& operator=(const LinuxProcess&) = delete;
 
-}
\ No newline at end of file
+        std::uint32_t get_pid() override
+        {
+            return _pid;
+        }
+
+        bool attached() override;
+
+        /*
+         * Call func for every line of /proc/<pid>/maps in address order until it returns true
+         * Works for any pid that can be read, including our own, false when the file can't be opened
+         */
+        static bool for_each_mapping(std::uint32_t pid, const RegionCallbackFn& func);
+
+        // how memory is accessed, picked when attaching
+        [[nodiscard]] AccessMethod access_method() const
+        {
+            return _method;
+        }
+
+      protected:
+        void enumerate_regions(const RegionCallbackFn& func) override;
+        bool read_impl(std::uintptr_t address, void* buffer, std::size_t size) override;
+        void read_many_impl(std::span<impl::ReadRequest> requests) override;
+        bool write_impl(std::uintptr_t address, void* buffer, std::size_t size) override;
+        void write_many_impl(std::span<impl::WriteRequest> requests) override;
+        bool attach_by_process_name(std::string_view process_name) override;
+    };
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "process.hpp"
+#include <cstdint>
+#include <shared_mutex>
+#include <span>
+#include <vector>
+
+namespace gensokyo
+{
+    /*
+     * The process this runs in, behind the same interface as a remote one
+     * Reads and writes are a memcpy after checking the range against a copy of the memory map, a range that isn't in it makes the map be read again once
+     * Memory unmapped after the map was read isn't noticed, call refresh() after freeing what might still be read through this
+     */
+    class LocalProcess : public impl::Process
+    {
+        // sorted, adjacent ranges with the same access are merged
+        std::vector<impl::MemoryRegion> _readable {};
+        std::vector<impl::MemoryRegion> _writable {};
+        mutable std::shared_mutex _mutex {};
+
+        static bool covers(const std::vector<impl::MemoryRegion>& ranges, std::uintptr_t address, std::size_t size) noexcept;
+
+        // check a range against the map, reading it again once when the range isn't in it
+        bool check(std::uintptr_t address, std::size_t size, bool write);
+
+      public:
+        LocalProcess();
+
+        LocalProcess(const LocalProcess&)            = delete;
+        LocalProcess& operator=(const LocalProcess&) = delete;
+
+        // read the memory map again
+        void refresh();
+
+        /*
+         * The memory itself without copying, empty when the range isn't readable
+         * Stays valid until the memory is freed, nothing here keeps it alive
+         */
+        std::span<const std::uint8_t> view(std::uintptr_t address, std::size_t size);
+
+        std::uint32_t get_pid() override;
+
+        bool attached() override
+        {
+            return true;
+        }
+
+      protected:
+        void enumerate_regions(const RegionCallbackFn& func) override;
+        bool read_impl(std::uintptr_t address, void* buffer, std::size_t size) override;
+        void read_many_impl(std::span<impl::ReadRequest> requests) override;
+        bool write_impl(std::uintptr_t address, void* buffer, std::size_t size) override;
+    };
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "process.hpp"
+#include "soft_dirty.hpp"
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace gensokyo
+{
+    /*
+     * Keeps a copy of some regions of another process and tells which bytes changed since the last poll
+     *
+     * With soft_dirty the kernel tells which pages were written, only those are read and compared, the others are skipped
+     * A write that lands between reading the bits and clearing them is only seen once its page is written again,
+     * or by the next full poll, every full_poll_interval-th poll compares every region in full
+     * When the kernel or permissions don't allow it every region is read and compared in full
+     */
+    class MemoryWatch
+    {
+        struct Watched
+        {
+            impl::MemoryRegion region {};
+            std::vector<std::uint8_t> snapshot {};
+        };
+
+        impl::Process& _process;
+        std::vector<Watched> _watched {};
+        std::optional<impl::SoftDirty> _soft_dirty {};
+
+        // reused between polls
+        std::vector<std::uint8_t> _buffer {};
+        std::size_t _polls {};
+
+      public:
+        static constexpr std::size_t full_poll_interval = 64;
+
+        explicit MemoryWatch(impl::Process& process, bool soft_dirty = false);
+
+        // start watching region from its current content, returns the index of it or nothing when it can't be read
+        std::optional<std::size_t> add(const impl::MemoryRegion& region);
+        void clear();
+
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            return _watched.size();
+        }
+
+        // whether polls skip pages through the soft-dirty bits
+        [[nodiscard]] bool uses_soft_dirty() const noexcept
+        {
+            return _soft_dirty && _soft_dirty->is_open();
+        }
+
+        /*
+         * Read the watched regions again and return every run of bytes that differs from the last poll, in the order the regions were added
+         * The snapshots are updated, a range that fails to read keeps its old content and reports nothing
+         */
+        std::vector<impl::MemoryRegion> poll();
+
+        // content of a region as of the last poll
+        [[nodiscard]] std::span<const std::uint8_t> snapshot(std::size_t index) const
+        {
+            return _watched.at(index).snapshot;
+        }
+    };
+}
@@ -1,6 +1,9 @@
 #pragma once
 
+#include "address.hpp"
+#include "pattern.hpp"
 #include <cstdint>
+#include <memory>
 #include <stdint.h>
 #include <string>
 #include <string_view>
@@ -10,6 +13,9 @@
 
 namespace gensokyo::impl
 {
+    class Process;
+    struct ModuleInfo;
+
     struct Segments
     {
         Segments() = default;
@@ -29,6 +35,18 @@ namespace gensokyo::impl
         std::span<std::uint8_t> data {};
     };
 
+    /*
+     * Identifies one build of a module, two modules with the same identity have the same bytes at the same offsets
+     * PE: TimeDateStamp in the high and CheckSum in the low half, ELF: hash of the GNU build-id note
+     */
+    struct ModuleIdentity
+    {
+        std::uint64_t build {};
+        std::uint64_t size {};
+
+        bool operator==(const ModuleIdentity&) const = default;
+    };
+
     class Module
     {
       public:
@@ -38,8 +56,14 @@ namespace gensokyo::impl
         std::vector<Segments> _segments {};
         std::uintptr_t _baseAddress {};
         std::size_t _size {};
+        ModuleIdentity _identity {};
+
+        // shared by copies of this, closed with the last one
+        std::shared_ptr<void> _handle {};
+
+        // copy of the segments of a module in another process, shared by copies of this
+        std::shared_ptr<std::vector<std::uint8_t>> _storage {};
 
-        void* _handle {};
         void get_module_nfo(std::string_view mod, const FunctionCallbackFn& func = nullptr);
 
       public:
@@ -51,6 +75,14 @@ namespace gensokyo::impl
 
         explicit Module(std::string_view str, const FunctionCallbackFn& func = nullptr);
 
+        /*
+         * A module of another process, found by name in process.modules() like the constructor above, an empty name is the program
+         * The segments are copied out of the process with one read_many, they don't follow changes made after that
+         * There's no handle, get_proc() throws
+         */
+        Module(Process& process, std::string_view str, const FunctionCallbackFn& func = nullptr);
+        Module(Process& process, const ModuleInfo& info, const FunctionCallbackFn& func = nullptr);
+
         // get rwx segments of a module
         std::vector<Segments>& get_segments()
         {
@@ -63,6 +95,28 @@ namespace gensokyo::impl
             return _baseAddress;
         }
 
+        // get size of a module image
+        [[nodiscard]] std::size_t size() const
+        {
+            return _size;
+        }
+
+        // get the build of a module, used to key anything derived from its bytes
+        [[nodiscard]] const ModuleIdentity& identity() const
+        {
+            return _identity;
+        }
+
         void* get_proc(std::string_view proc_name);
+
+        // first match in the segments, in segment order, the address is segment.address based
+        [[nodiscard]] gensokyo::Address find(pattern::impl::PatternView pattern) const noexcept;
+
+        // same result, the segments are split into chunks that are scanned on the thread pool
+        [[nodiscard]] gensokyo::Address find(pattern::parallel_t, pattern::impl::PatternView pattern) const;
+
+        // every match in every segment, in segment order
+        [[nodiscard]] std::vector<gensokyo::Address> find_all(pattern::impl::PatternView pattern) const;
+        [[nodiscard]] std::vector<gensokyo::Address> find_all(pattern::parallel_t, pattern::impl::PatternView pattern) const;
     };
 }
@@ -1,18 +1,145 @@
 #pragma once
 
 #include "address.hpp"
+#include "../helper/simd.hpp"
 #include <algorithm>
+#include <bit>
 #include <optional>
 #include <stdexcept>
 #include <vector>
 #include <array>
 #include <ranges>
+#include <span>
+#include <iterator>
+#include <utility>
 
 namespace gensokyo::pattern
 {
     namespace impl
     {
-        using HexData = std::optional<std::uint8_t>;
+        // a pattern byte, only the bits set in mask have to match, e.g ? has a mask of 0x00 and A? a mask of 0xF0
+        struct HexData
+        {
+            std::uint8_t byte {};
+            std::uint8_t mask {};
+
+            constexpr HexData() noexcept = default;
+
+            constexpr HexData(std::nullopt_t) noexcept
+            {
+            }
+
+            constexpr HexData(std::uint8_t byte_, std::uint8_t mask_ = 0xFF) noexcept
+             : byte(byte_ & mask_),
+               mask(mask_)
+            {
+            }
+
+            // false only for a full wildcard
+            [[nodiscard]] constexpr bool has_value() const noexcept
+            {
+                return mask != 0;
+            }
+
+            // every bit is known, only these bytes can anchor a scan
+            [[nodiscard]] constexpr bool is_exact() const noexcept
+            {
+                return mask == 0xFF;
+            }
+
+            [[nodiscard]] constexpr std::uint8_t value() const noexcept
+            {
+                return byte;
+            }
+
+            [[nodiscard]] constexpr std::uint8_t operator*() const noexcept
+            {
+                return byte;
+            }
+
+            constexpr explicit operator bool() const noexcept
+            {
+                return has_value();
+            }
+
+            [[nodiscard]] constexpr bool matches(std::uint8_t data) const noexcept
+            {
+                return (data & mask) == byte;
+            }
+
+            constexpr bool operator==(const HexData&) const noexcept = default;
+
+            constexpr bool operator==(std::uint8_t other) const noexcept
+            {
+                return is_exact() && byte == other;
+            }
+        };
+
+        // what the scanners take, anything that stores pattern bytes contiguously converts to it without a copy
+        using PatternView = std::span<const HexData>;
+
+        // pattern bytes are stored inline up to inline_capacity, so most signatures never allocate
+        class PatternBytes
+        {
+          public:
+            static constexpr std::size_t inline_capacity = 64;
+
+            constexpr void push_back(const HexData& value)
+            {
+                if (_size < inline_capacity)
+                {
+                    _inline[_size++] = value;
+                    return;
+                }
+
+                // only move to the heap once the inline storage is full
+                if (_size == inline_capacity)
+                    _heap.assign(_inline.begin(), _inline.end());
+
+                _heap.push_back(value);
+                _size++;
+            }
+
+            constexpr const HexData* data() const noexcept
+            {
+                return _size > inline_capacity ? _heap.data() : _inline.data();
+            }
+
+            constexpr std::size_t size() const noexcept
+            {
+                return _size;
+            }
+
+            constexpr bool empty() const noexcept
+            {
+                return _size == 0;
+            }
+
+            constexpr const HexData* begin() const noexcept
+            {
+                return data();
+            }
+
+            constexpr const HexData* end() const noexcept
+            {
+                return data() + _size;
+            }
+
+            constexpr const HexData& operator[](std::size_t index) const noexcept
+            {
+                return data()[index];
+            }
+
+            constexpr const HexData& front() const noexcept
+            {
+                return data()[0];
+            }
+
+          private:
+            std::array<HexData, inline_capacity> _inline {};
+            std::vector<HexData> _heap {};
+            std::size_t _size {};
+        };
 
         [[nodiscard]] static constexpr std::optional<uint8_t> hex_char_to_byte(char c) noexcept
         {
@@ -27,7 +154,7 @@ namespace gensokyo::pattern
         }
 
         template <char Wildcard = '?'>
-        [[nodiscard]] static constexpr std::optional<std::uint8_t> parse_hex(std::string_view str) noexcept
+        [[nodiscard]] static constexpr HexData parse_hex(std::string_view str) noexcept
         {
             if (str.size() == 1 && str.front() == Wildcard)
                 return std::nullopt;
@@ -41,23 +168,20 @@ namespace gensokyo::pattern
             // if both are not wildcard, e.g AA
             if (high.has_value() && low.has_value())
             {
-                return (high.value() << 4) | low.value();
+                return static_cast<std::uint8_t>((high.value() << 4) | low.value());
             }
-
-            return std::nullopt;
-            /*
-            comment these out when find pattern supports this kind of pattern
             // A?
-            else if (high.has_value() && !low.has_value())
+            else if (high.has_value() && str[1] == Wildcard)
             {
-                return high.value() << 4;
+                return { static_cast<std::uint8_t>(high.value() << 4), 0xF0 };
             }
             // ?A
-            else if (!high.has_value() && low.has_value())
+            else if (str[0] == Wildcard && low.has_value())
             {
-                return low.value();
+                return { low.value(), 0x0F };
             }
-            */
+
+            return std::nullopt;
         }
 
         template <char Delimiter = ' ', char Wildcard = '?'>
@@ -93,14 +217,26 @@ namespace gensokyo::pattern
             return arr;
         }
 
+        // a string literal that can be passed as a template argument, e.g find<"48 8B ? ? 89">
+        template <std::size_t N>
+        struct FixedString
+        {
+            std::array<char, N> chars {};
+
+            constexpr FixedString(const char (&str)[N]) noexcept
+            {
+                for (std::size_t i = 0; i < N; i++)
+                    chars[i] = str[i];
+            }
+        };
+
         template <char Delimiter = ' ', char Wildcard = '?'>
         struct Pattern
         {
             constexpr Pattern(std::string_view pattern)
             {
-                bytes = parse_pattern<Delimiter, Wildcard>(pattern);
-                if (!bytes.front().has_value())
-                    throw std::invalid_argument("A pattern shouldn't start with a wildcard!!");
+                for (const auto& str : pattern | std::views::split(Delimiter))
+                    bytes.push_back(parse_hex<Wildcard>(std::string_view(str)));
             }
 
             constexpr std::size_t size() const noexcept
@@ -113,18 +249,333 @@ namespace gensokyo::pattern
                 return bytes[index];
             }
 
-            std::vector<HexData> bytes;
+            operator PatternView() const noexcept
+            {
+                return bytes;
+            }
+
+            PatternBytes bytes;
+        };
+
+        /*
+         * How common each byte value is in x86-64 code, 0 is the rarest and 255 the most common
+         * Ranked from the .text sections of a few hundred x86-64 binaries, 0xCC is moved up since MSVC pads functions with it
+         */
+        inline constexpr std::array<std::uint8_t, 256> byte_frequency {
+            255, 248, 228, 216, 234, 224, 176, 190, 239, 152, 134, 121, 174, 145, 107, 249, // 0x
+            235, 204, 106,  95, 148, 163,  84,  72, 223,  79,  57,  61, 119,  87,  78, 231, // 1x
+            225,  99,  41,  47, 251, 150,  31,  39, 215, 203,  44, 101, 112,  74, 165,  50, // 2x
+            210, 229,  27,  63, 116, 166,  28,  34, 197, 226,  52, 146, 172, 184,  53,  82, // 3x
+            227, 243, 109, 192, 241, 220, 122, 159, 254, 238,  83,  93, 246, 212,  64,  71, // 4x
+            207,  55,  37, 180, 206, 193, 135, 141, 157,  25,  18, 181, 194, 199, 138, 125, // 5x
+            170,  15,  11, 108, 154,  48, 233,  21, 153,  29,  43,  58, 144,  54,  88, 130, // 6x
+            195,  20,  96, 123, 236, 221,  97, 111, 158,  30,  26, 120, 208, 118,  90, 142, // 7x
+            219, 171,  65, 242, 245, 240,  73, 104, 173, 252,  59, 250, 132, 244,  45,  40, // 8x
+            205,   9,  33,  35, 140,  67,  19,  16, 114,  91,   3,  13,  89,  32,  12,   6, // 9x
+            124,   1,   0,  24,  51,   8,  22,   5, 110,  14,  49,  23, 100,  10,   2,  46, // Ax
+            127,   7,   4,  17, 131,  42, 168, 143, 186, 137, 196,  68, 183, 103, 198, 169, // Bx
+            237, 217, 177, 218, 191, 178, 213, 230, 164, 155,  92,  38, 250,  62,  75,  76, // Cx
+            179, 117, 182,  98,  60,  80,  85,  77, 147,  70,  94, 139,  36,  69, 129, 202, // Dx
+            187, 115, 128,  66, 105,  81, 133, 151, 247, 232, 136, 214, 156, 162, 161, 201, // Ex
+            189, 102, 126, 149,  86, 113, 211, 188, 209, 160, 185, 175, 167, 200, 222, 253, // Fx
         };
 
-        gensokyo::Address find_brute_force(std::uint8_t* data, std::size_t size, const std::span<HexData>& pattern) noexcept;
-        gensokyo::Address find_std(std::uint8_t* data, std::size_t size, const std::span<HexData>& pattern) noexcept;
+        /*
+         * Index of the concrete byte that shows up least in x86 code, skipping the one at skip
+         * Without concrete bytes it's the one with the most known bits, pattern.size() when every byte is a wildcard
+         */
+        [[nodiscard]] constexpr std::size_t find_anchor(PatternView pattern, std::size_t skip = static_cast<std::size_t>(-1)) noexcept
+        {
+            constexpr auto rarer = [](const HexData& a, const HexData& b)
+            {
+                if (a.is_exact() && b.is_exact())
+                    return byte_frequency[a.byte] < byte_frequency[b.byte];
 
+                return std::popcount(a.mask) > std::popcount(b.mask);
+            };
+
+            auto anchor = pattern.size();
+            for (std::size_t i = 0; i < pattern.size(); i++)
+            {
+                if (i != skip && pattern[i].has_value() && (anchor == pattern.size() || rarer(pattern[i], pattern[anchor])))
+                    anchor = i;
+            }
+            return anchor;
+        }
+
+        // check if pattern matches the bytes at data, caller makes sure that data has at least pattern.size() bytes
+        [[nodiscard]] bool matches(const std::uint8_t* data, PatternView pattern) noexcept;
+
+        gensokyo::Address find_brute_force(std::uint8_t* data, std::size_t size, PatternView pattern) noexcept;
+        gensokyo::Address find_std(std::uint8_t* data, std::size_t size, PatternView pattern) noexcept;
+
+        // DualAnchor also compares the second rarest byte before a candidate is verified, fewer candidates for one more compare per block
+        template <typename SIMD, bool DualAnchor = false>
+        gensokyo::Address find_simd(std::uint8_t* data, std::size_t size, PatternView pattern) noexcept;
+
+        // a scan that can be resumed after a match, the pattern masks and the candidate bits of the current block are kept between calls
+        struct ScanState
+        {
+            ScanState() = default;
+            ScanState(std::uint8_t* data_, std::size_t size_, PatternView pattern_) noexcept;
+
+            std::uint8_t* data {};
+            std::size_t size {};
+            PatternView pattern {};
+
+            // longest pattern the simd kernels verify, checked as several registers one after another
+            static constexpr std::size_t max_simd_pattern = 256;
+
+            // the two rarest bytes of the pattern, blocks are searched for them before the whole pattern is compared
+            std::size_t anchor {};
+            std::size_t second_anchor {};
+
+            // pattern bytes and the bits of them that have to match
+            std::array<std::uint8_t, max_simd_pattern> bytes {};
+            std::array<std::uint8_t, max_simd_pattern> masks {};
+
+            // where the next block starts, the candidates in mask belong to the block before it
+            std::size_t offset {};
+            std::uint64_t mask {};
+        };
+
+        using ScanNextFn = gensokyo::Address (*)(ScanState&) noexcept;
+
+        // both return the next match and move state after it, an empty address means there are no more matches
+        gensokyo::Address find_std_next(ScanState& state) noexcept;
+
+        template <typename SIMD, bool DualAnchor = false>
+        gensokyo::Address find_simd_next(ScanState& state) noexcept;
+
+        // whether the anchor is common enough that comparing a second byte per block pays for itself
+        [[nodiscard]] bool prefer_dual_anchor(const ScanState& state) noexcept;
+
+        // every pattern is anchored on up to 4 concrete bytes, a position is only verified when the hash of its bytes is in the pattern set
+        std::vector<gensokyo::Address> find_many_std(std::uint8_t* data, std::size_t size, std::span<const Pattern<>> patterns);
+
+        // Teddy style multi pattern search, https://github.com/BurntSushi/aho-corasick/tree/master/src/packed/teddy
         template <typename SIMD>
-        gensokyo::Address find_simd(std::uint8_t* data, std::size_t size, const std::span<HexData>& pattern) noexcept;
+        std::vector<gensokyo::Address> find_many_simd(std::uint8_t* data, std::size_t size, std::span<const Pattern<>> patterns);
+    }
+
+    gensokyo::Address find(const std::span<std::uint8_t>& data, const impl::Pattern<>& pattern) noexcept;
+    gensokyo::Address find(const std::span<std::uint8_t>& data, impl::PatternView pattern) noexcept;
+
+    // policy tag for scanning a single buffer on the thread pool, e.g find(pattern::parallel, data, pattern)
+    struct parallel_t
+    {
+        explicit parallel_t() = default;
+    };
+
+    inline constexpr parallel_t parallel {};
+
+    /*
+     * Split data into chunks that overlap by pattern.size() - 1 bytes and scan them on the thread pool
+     * Returns the lowest match like find, chunks after the best match so far are skipped
+     * Throws, the pool allocates and rethrows what a chunk threw
+     */
+    gensokyo::Address find(parallel_t, const std::span<std::uint8_t>& data, const impl::Pattern<>& pattern);
+    gensokyo::Address find(parallel_t, const std::span<std::uint8_t>& data, impl::PatternView pattern);
+
+    // Every match of a pattern in ascending order, matches are searched lazily while iterating
+    class MatchRange : public std::ranges::view_interface<MatchRange>
+    {
+        impl::ScanState _state {};
+        impl::ScanNextFn _next {};
+        gensokyo::Address _current {};
+
+      public:
+        class iterator
+        {
+            MatchRange* _range {};
+
+          public:
+            using value_type      = gensokyo::Address;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() = default;
+
+            explicit iterator(MatchRange* range)
+             : _range(range)
+            {
+            }
+
+            gensokyo::Address operator*() const
+            {
+                return _range->_current;
+            }
+
+            iterator& operator++()
+            {
+                _range->_current = _range->_next(_range->_state);
+                return *this;
+            }
+
+            void operator++(int)
+            {
+                ++*this;
+            }
+
+            bool operator==(std::default_sentinel_t) const
+            {
+                return !_range || !_range->_current.ptr;
+            }
+        };
+
+        MatchRange() = default;
+
+        MatchRange(const impl::ScanState& state, impl::ScanNextFn next)
+         : _state(state),
+           _next(next)
+        {
+        }
+
+        // can only be iterated once, like any other input range
+        iterator begin()
+        {
+            _current = _next(_state);
+            return iterator(this);
+        }
+
+        std::default_sentinel_t end() const noexcept
+        {
+            return {};
+        }
+    };
+
+    /*
+     * Find every match of pattern without restarting the scan after each match
+     * pattern must outlive the returned range
+     */
+    MatchRange find_all(const std::span<std::uint8_t>& data, impl::PatternView pattern) noexcept;
+    MatchRange find_all(const std::span<std::uint8_t>& data, const impl::Pattern<>& pattern) noexcept;
+
+    /*
+     * Scan data once for every pattern, the result at index i is the first match of patterns[i] or an empty address when it's not found
+     */
+    std::vector<gensokyo::Address> find_many(const std::span<std::uint8_t>& data, std::span<const impl::Pattern<>> patterns);
+
+    namespace impl
+    {
+        /*
+         * Scanner generated for one signature, the anchors, byte and mask registers and the verify steps are all constants
+         * Registers that are only wildcards are never compared and the anchor is only masked when it has unknown bits
+         */
+        template <typename SIMD, FixedString Signature>
+        gensokyo::Address find_compiled(std::uint8_t* data, std::size_t size) noexcept
+        {
+            static constexpr auto pattern = make_pattern<Signature.chars>();
+            constexpr std::size_t pattern_size  = pattern.size();
+            constexpr std::size_t simd_length   = SIMD::simd_length;
+            constexpr std::size_t num_registers = (pattern_size + simd_length - 1) / simd_length;
+            constexpr std::size_t anchor        = find_anchor(pattern);
+            constexpr std::size_t second_anchor = find_anchor(pattern, anchor);
+
+            static_assert(pattern_size > 0, "A pattern needs at least one byte");
+
+            if (pattern_size > size)
+                return {};
+
+            // nothing to anchor on, the first position matches
+            if constexpr (anchor == pattern_size)
+                return data;
+            else
+            {
+                // same rule as prefer_dual_anchor
+                constexpr bool dual = second_anchor != pattern_size && (!pattern[anchor].is_exact() || byte_frequency[pattern[anchor].byte] >= 128);
+
+                struct Registers
+                {
+                    alignas(64) std::array<std::uint8_t, num_registers * simd_length> bytes {};
+                    alignas(64) std::array<std::uint8_t, num_registers * simd_length> masks {};
+                    std::array<bool, num_registers> used {};
+                };
+
+                static constexpr auto registers = []
+                {
+                    Registers result {};
+                    for (std::size_t i = 0; i < pattern_size; i++)
+                    {
+                        result.bytes[i] = pattern[i].byte;
+                        result.masks[i] = pattern[i].mask;
+                        result.used[i / simd_length] |= pattern[i].has_value();
+                    }
+                    return result;
+                }();
+
+                const auto verify = [&]<std::size_t... I>(const std::uint8_t* candidate, std::index_sequence<I...>)
+                {
+                    return ((!registers.used[I] ||
+                             SIMD::equal_masked(SIMD::load_unaligned(candidate + I * simd_length),
+                                                SIMD::load_aligned(registers.bytes.data() + I * simd_length),
+                                                SIMD::load_aligned(registers.masks.data() + I * simd_length))) &&
+                            ...);
+                };
+
+                const auto matches_at = [&]<std::size_t... I>(const std::uint8_t* candidate, std::index_sequence<I...>)
+                {
+                    return ((!pattern[I].has_value() || pattern[I].matches(candidate[I])) && ...);
+                };
+
+                // loads the anchor block and keeps only the known bits of it
+                const auto load_anchor = [&]<std::size_t Index>(const std::uint8_t* block)
+                {
+                    const auto loaded = SIMD::load_unaligned(block + Index);
+                    if constexpr (pattern[Index].is_exact())
+                        return loaded;
+                    else
+                        return SIMD::and_si(loaded, SIMD::set1_epi8(pattern[Index].mask));
+                };
+
+                const auto anchor_byte = SIMD::set1_epi8(pattern[anchor].byte);
+                const auto second_byte = SIMD::set1_epi8(pattern[dual ? second_anchor : anchor].byte);
+
+                // a block loads simd_length bytes at the anchors and a candidate loads num_registers * simd_length bytes
+                constexpr std::size_t load_size = (num_registers + 1) * simd_length;
+
+                std::size_t offset = 0;
+                for (; offset + load_size <= size; offset += simd_length)
+                {
+                    const auto block = data + offset;
+                    auto mask        = SIMD::cmpeq_mask(anchor_byte, load_anchor.template operator()<anchor>(block));
+                    if constexpr (dual)
+                        mask &= SIMD::cmpeq_mask(second_byte, load_anchor.template operator()<second_anchor>(block));
+
+                    for (; mask; mask &= mask - 1)
+                    {
+                        const auto candidate = block + std::countr_zero(mask);
+                        if (verify(candidate, std::make_index_sequence<num_registers>()))
+                            return candidate;
+                    }
+                }
+
+                // Look in remaining bytes that couldn't be grouped into simd_length * 8 bits
+                for (; offset + pattern_size <= size; offset++)
+                {
+                    if (matches_at(data + offset, std::make_index_sequence<pattern_size>()))
+                        return data + offset;
+                }
+
+                return {};
+            }
+        }
     }
 
-    gensokyo::Address find(const std::span<std::uint8_t>& data, impl::Pattern<> pattern) noexcept;
-    gensokyo::Address find(const std::span<std::uint8_t>& data, const std::span<impl::HexData>& pattern) noexcept;
+    /*
+     * Find a signature that is known at compile time, e.g find<"48 8B ? ? 89">(data)
+     * The kernel is picked by the instruction sets this translation unit is compiled for
+     */
+    template <impl::FixedString Signature>
+    gensokyo::Address find(const std::span<std::uint8_t>& data) noexcept
+    {
+#if defined(__AVX512BW__)
+        return impl::find_compiled<simd::iAVX512, Signature>(data.data(), data.size());
+#elif defined(__AVX2__)
+        return impl::find_compiled<simd::iAVX2, Signature>(data.data(), data.size());
+#else
+        return impl::find_compiled<simd::iSSE, Signature>(data.data(), data.size());
+#endif
+    }
 
     using Type = impl::Pattern<' ', '?'>;
 }
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "address.hpp"
+#include "process.hpp"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace gensokyo
+{
+    /*
+     * Resolves many pointer chains of another process together, one read_many per level instead of one read per hop
+     * A chain starts at base, then for every offset a pointer is read there and the offset is added to it, like a PointerPath
+     * A chain that hits a failed read or a pointer that isn't a valid address resolves to an empty Address
+     */
+    class PointerResolver
+    {
+      public:
+        struct Chain
+        {
+            std::uintptr_t base {};
+            std::vector<std::uintptr_t> offsets {};
+        };
+
+      private:
+        impl::Process& _process;
+        std::vector<Chain> _chains {};
+        std::vector<gensokyo::Address> _results {};
+
+      public:
+        explicit PointerResolver(impl::Process& process);
+
+        // returns the index of the chain, results are in the same order
+        std::size_t add(Chain chain);
+        void clear();
+
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            return _chains.size();
+        }
+
+        // resolve every chain again, e.g once per tick, returns how many resolved
+        std::size_t resolve();
+
+        // from the last resolve()
+        [[nodiscard]] gensokyo::Address result(std::size_t index) const
+        {
+            return _results.at(index);
+        }
+
+        [[nodiscard]] std::span<const gensokyo::Address> results() const noexcept
+        {
+            return _results;
+        }
+
+        // one time resolve of chains, without keeping them
+        static std::vector<gensokyo::Address> resolve(impl::Process& process, std::span<const Chain> chains);
+    };
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "pointer_resolver.hpp"
+#include "process.hpp"
+#include <compare>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace gensokyo
+{
+    /*
+     * A chain of pointers from a module to an address
+     * Start at the module base plus offset, then for every entry of offsets read a pointer there and add the entry to it
+     */
+    struct PointerPath
+    {
+        // file name of the module, like "game.exe" or "libc.so.6"
+        std::string module {};
+        std::uintptr_t offset {};
+        std::vector<std::uintptr_t> offsets {};
+
+        auto operator<=>(const PointerPath&) const = default;
+
+        // "game.exe+0x1a2b0,0x10,0x8"
+        [[nodiscard]] std::string to_string() const;
+        [[nodiscard]] static std::optional<PointerPath> parse(std::string_view text);
+    };
+
+    /*
+     * Finds pointer paths from the static data of modules to an address, to get to it again after it moved
+     *
+     * snapshot() reads every region in the filter once and indexes the pointers in it by the address they point to
+     * scan() then walks back from the target, at every level looking for pointers to at most max_offset below the addresses of the previous level,
+     * until it reaches writable memory of a module or max_depth
+     * An address is only expanded at the first level it's found on, so cycles and longer detours through it aren't followed,
+     * static addresses end a path on every level they're found on
+     *
+     * Save the results, and after the target restarted keep the ones that still lead to the new address with rescan()
+     */
+    class PointerScanner
+    {
+      public:
+        struct Options
+        {
+            std::size_t max_depth   = 5;
+            std::size_t max_offset  = 0x1000;
+            std::size_t max_results = 100000;
+
+            // regions that are indexed, pointers are only followed into these
+            impl::RegionFilter filter = { .readable = true, .writable = true };
+        };
+
+      private:
+        struct Pointer
+        {
+            // where it points to and where it is
+            std::uintptr_t value {};
+            std::uintptr_t address {};
+        };
+
+        // told apart by path, two files of the same name are two modules, paths only keep the name
+        struct Module
+        {
+            std::string path {};
+            std::string name {};
+            std::uintptr_t base {};
+            std::size_t size {};
+        };
+
+        // writable memory of a module, its .data and .bss
+        struct StaticRange
+        {
+            impl::MemoryRegion region {};
+            std::size_t module {};
+        };
+
+        impl::Process& _process;
+        Options _options {};
+
+        std::vector<Module> _modules {};
+        std::vector<StaticRange> _statics {};
+
+        // sorted by value
+        std::vector<Pointer> _pointers {};
+
+        void refresh_modules();
+        [[nodiscard]] const StaticRange* find_static(std::uintptr_t address) const noexcept;
+
+        // the start of path in the process now, none when its module isn't loaded
+        [[nodiscard]] std::optional<PointerResolver::Chain> chain(const PointerPath& path) const;
+
+      public:
+        explicit PointerScanner(impl::Process& process);
+        PointerScanner(impl::Process& process, Options options);
+
+        // read and index every region in the filter, again after the process changed a lot since the last one
+        void snapshot();
+
+        // every path to target up to the limits of the options, sorted, taking a snapshot first when there is none
+        std::vector<PointerPath> scan(std::uintptr_t target);
+
+        // where path leads to in the process now
+        std::optional<std::uintptr_t> resolve(const PointerPath& path);
+
+        // the paths that lead to target in the process now, for paths from an earlier run of it, resolved together through a PointerResolver
+        std::vector<PointerPath> rescan(std::span<const PointerPath> paths, std::uintptr_t target);
+
+        [[nodiscard]] std::size_t pointer_count() const noexcept
+        {
+            return _pointers.size();
+        }
+
+        // one path per line, in the format of PointerPath::to_string
+        static void save(const std::filesystem::path& file, std::span<const PointerPath> paths);
+        static std::vector<PointerPath> load(const std::filesystem::path& file);
+    };
+}
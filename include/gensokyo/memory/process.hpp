@@ -1,14 +1,125 @@
 #pragma once
 
+#include "address.hpp"
+#include "module.hpp"
+#include "pattern.hpp"
 #include <cstdint>
+#include <functional>
+#include <mutex>
 #include <optional>
+#include <span>
+#include <string>
 #include <string_view>
+#include <vector>
 
 namespace gensokyo::impl
 {
+    struct MemoryRegion
+    {
+        std::uintptr_t address {};
+        std::size_t size {};
+    };
+
+    // one mapping of a process, as the OS reports it
+    struct Region : MemoryRegion
+    {
+        bool readable {};
+        bool writable {};
+        bool executable {};
+
+        // mapped from a file, MEM_IMAGE on windows and any file backed mapping on linux
+        bool image {};
+
+        // backing file or a pseudo name like [heap], empty for anonymous memory
+        std::string path {};
+
+        // where the mapping starts in its file on linux, how far it is from the start of its allocation on windows
+        std::size_t offset {};
+    };
+
+    // regions have to have every property that's set here
+    struct RegionFilter
+    {
+        bool readable {};
+        bool writable {};
+        bool executable {};
+        bool image {};
+
+        [[nodiscard]] bool matches(const Region& region) const noexcept
+        {
+            return (!readable || region.readable) && (!writable || region.writable) && (!executable || region.executable) && (!image || region.image);
+        }
+    };
+
+    // a module loaded in a process, as Process::modules() lists it
+    struct ModuleInfo
+    {
+        // file name and the path the OS reports, NT device paths on windows
+        std::string name {};
+        std::string path {};
+
+        std::uintptr_t base {};
+        std::size_t size {};
+        ModuleIdentity identity {};
+
+        // the program itself rather than a library
+        bool program {};
+
+        // readable and executable parts, the ranges Module::get_segments() has for a module of this process
+        std::vector<MemoryRegion> code {};
+    };
+
+    struct ReadRequest
+    {
+        std::uintptr_t address {};
+        void* buffer {};
+        std::size_t size {};
+
+        // set by read_many
+        bool success {};
+    };
+
+    struct WriteRequest
+    {
+        std::uintptr_t address {};
+        const void* buffer {};
+        std::size_t size {};
+
+        // set by write_many
+        bool success {};
+    };
+
     class Process
     {
+        // a file mapped as an image and what its headers said, nullopt when it isn't a module
+        struct CachedModule
+        {
+            std::string path {};
+            std::uintptr_t address {};
+            std::size_t size {};
+            std::optional<ModuleInfo> module {};
+        };
+
+        std::vector<CachedModule> _module_cache {};
+        std::mutex _module_mutex {};
+
+        /*
+         * Fill in the rest of modules from their headers, the ELF or PE format of the platform
+         * They come with the name, path, base and the size of the mappings, returns which ones are modules
+         */
+        std::vector<bool> read_module_headers(std::span<ModuleInfo> modules);
+
       public:
+        using ChunkCallbackFn = std::function<bool(std::span<std::uint8_t> data, std::uintptr_t address)>;
+
+        // return true to stop the enumeration
+        using RegionCallbackFn = std::function<bool(const Region& region)>;
+
+        // big enough to amortize a read call, small enough to stay in L2 while it's scanned
+        static constexpr std::size_t scan_chunk_size = 256 * 1024;
+
+        virtual ~Process() = default;
+
         bool read(std::uintptr_t address, void* buffer, std::size_t size);
         bool write(std::uintptr_t address, void* buffer, std::size_t size);
 
@@ -28,6 +139,38 @@ namespace gensokyo::impl
             return write(address, &value, sizeof(T));
         }
 
+        // read every request in as few calls as the backend allows, returns how many succeeded
+        std::size_t read_many(std::span<ReadRequest> requests);
+
+        // write every request in as few calls as the backend allows, where requests overlap the later one wins, returns how many succeeded
+        std::size_t write_many(std::span<WriteRequest> requests);
+
+        /*
+         * Call func for every readable chunk of region until it returns true, chunks overlap by overlap bytes
+         * Chunk N is passed to func while chunk N + 1 is read on the thread pool, a chunk that fails to read is skipped
+         */
+        void scan(const MemoryRegion& region, std::size_t overlap, std::size_t chunk_size, const ChunkCallbackFn& func);
+
+        /*
+         * Search region through scan() without copying all of it
+         * The tail of a chunk is carried over so matches across chunks are found, matches can't cross a chunk that failed to read
+         */
+        gensokyo::Address find(const MemoryRegion& region, pattern::impl::PatternView pattern, std::size_t chunk_size = scan_chunk_size);
+        std::vector<gensokyo::Address> find_all(const MemoryRegion& region, pattern::impl::PatternView pattern, std::size_t chunk_size = scan_chunk_size);
+
+        /*
+         * Call func for every committed region that passes filter, in address order, until it returns true
+         * The region passed to func is reused between calls, copy what should outlive the call
+         */
+        void for_each_region(const RegionFilter& filter, const RegionCallbackFn& func);
+        std::vector<Region> regions(const RegionFilter& filter = {});
+
+        /*
+         * Every module loaded in the process in address order, from the files mapped as images and their headers
+         * The headers are read with a few read_many for all modules together and kept, a module is only read again when its mappings change
+         */
+        std::vector<ModuleInfo> modules();
+
         virtual std::uint32_t get_pid()
         {
             return 0;
@@ -44,11 +187,28 @@ namespace gensokyo::impl
             return true;
         }
 
+        /*
+         * Requests close to each other are merged into one read of the whole range and copied out
+         * When a merged read fails its requests are read one by one, so one bad address only fails its own request
+         */
+        virtual void read_many_impl(std::span<ReadRequest> requests);
+
+        // every region of the process in address order, nothing by default
+        virtual void enumerate_regions([[maybe_unused]] const RegionCallbackFn& func)
+        {
+        }
+
         virtual bool write_impl([[maybe_unused]] std::uintptr_t address, [[maybe_unused]] void* buffer, [[maybe_unused]] std::size_t size)
         {
             return true;
         }
 
+        /*
+         * Requests that touch or overlap are copied into one buffer and written with one call
+         * Gaps are never filled, that would need a read first, when a merged write fails its requests are written one by one
+         */
+        virtual void write_many_impl(std::span<WriteRequest> requests);
+
         virtual bool attach_by_process_name([[maybe_unused]] std::string_view process_name)
         {
             return true;
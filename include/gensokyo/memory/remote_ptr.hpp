@@ -0,0 +1,250 @@
+#pragma once
+
+#include "address.hpp"
+#include "process.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace gensokyo
+{
+    /*
+     * A T in another process that's read lazily, field by field
+     * Fields named with field() are read together with one read_many on the first access, the rest of the local copy stays zero
+     * When nothing was named the whole T is read, a field first asked for after a fetch makes every named field be read again
+     * Pointers inside T are addresses in the other process, follow() turns them into another RemotePtr
+     */
+    template <typename T>
+    class RemotePtr
+    {
+        static_assert(std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>, "RemotePtr needs a plain struct");
+
+        impl::Process* _process {};
+        gensokyo::Address _address {};
+        T _value {};
+
+        // ranges of T to read, sorted and merged, the address is the offset into T
+        std::vector<impl::MemoryRegion> _fields {};
+        bool _fetched {};
+        bool _valid {};
+
+        template <typename U>
+        [[nodiscard]] std::size_t offset_of(U T::*member) const noexcept
+        {
+            return static_cast<std::size_t>(reinterpret_cast<const std::uint8_t*>(std::addressof(_value.*member)) - reinterpret_cast<const std::uint8_t*>(std::addressof(_value)));
+        }
+
+        [[nodiscard]] bool recorded(std::size_t offset, std::size_t size) const noexcept
+        {
+            return std::ranges::any_of(_fields,
+                                       [&](const impl::MemoryRegion& field)
+                                       {
+                                           return offset >= field.address && offset + size <= field.address + field.size;
+                                       });
+        }
+
+        // queue the reads of every named field, false when the address can't be read at all
+        bool prepare(std::vector<impl::ReadRequest>& requests)
+        {
+            _fetched = true;
+            _valid   = false;
+            _value   = {};
+
+            if (!_process || !_address.is_valid())
+                return false;
+
+            if (_fields.empty())
+                _fields.push_back({ 0, sizeof(T) });
+
+            auto* data = reinterpret_cast<std::uint8_t*>(std::addressof(_value));
+            for (const auto& field : _fields)
+                requests.push_back({ _address.ptr + field.address, data + field.address, field.size });
+
+            return true;
+        }
+
+        // a failed read leaves part of the copy written, don't hand that out
+        void finish(std::span<const impl::ReadRequest> requests)
+        {
+            _valid = std::ranges::all_of(requests, &impl::ReadRequest::success);
+            if (!_valid)
+                _value = {};
+        }
+
+      public:
+        RemotePtr() = default;
+
+        RemotePtr(impl::Process& process, gensokyo::Address address)
+         : _process(&process),
+           _address(address)
+        {
+        }
+
+        // name a field to read on the next fetch, ranges that touch are read as one
+        template <typename U>
+        RemotePtr& field(U T::*member)
+        {
+            const auto offset = offset_of(member);
+            if (recorded(offset, sizeof(U)))
+                return *this;
+
+            impl::MemoryRegion added { offset, sizeof(U) };
+            const auto first = std::ranges::find_if(_fields,
+                                                    [&](const impl::MemoryRegion& field)
+                                                    {
+                                                        return field.address + field.size >= added.address;
+                                                    });
+
+            auto last = first;
+            for (; last != _fields.end() && last->address <= added.address + added.size; ++last)
+            {
+                const auto end = std::max(added.address + added.size, last->address + last->size);
+                added.address  = std::min(added.address, last->address);
+                added.size     = end - added.address;
+            }
+
+            _fields.insert(_fields.erase(first, last), added);
+            _fetched = false;
+            return *this;
+        }
+
+        // read the named fields now, true when all of them could be read
+        bool fetch()
+        {
+            std::vector<impl::ReadRequest> requests {};
+            if (!prepare(requests))
+                return false;
+
+            _process->read_many(requests);
+            finish(requests);
+            return _valid;
+        }
+
+        /*
+         * Fetch every pointer with one read_many per process they point into
+         * Returns how many were read fully
+         */
+        static std::size_t fetch_all(std::span<RemotePtr> pointers)
+        {
+            // the requests of a pointer, in the list of its process
+            struct Queued
+            {
+                std::size_t group {};
+                std::size_t first {};
+                std::size_t last {};
+            };
+
+            std::vector<impl::Process*> processes {};
+            std::vector<std::vector<impl::ReadRequest>> requests {};
+            std::vector<Queued> queued(pointers.size());
+
+            for (std::size_t i = 0; i < pointers.size(); i++)
+            {
+                auto& pointer    = pointers[i];
+                const auto group = static_cast<std::size_t>(std::ranges::find(processes, pointer._process) - processes.begin());
+                if (group == processes.size())
+                {
+                    processes.push_back(pointer._process);
+                    requests.emplace_back();
+                }
+
+                queued[i] = { group, requests[group].size() };
+                pointer.prepare(requests[group]);
+                queued[i].last = requests[group].size();
+            }
+
+            // pointers without a process or address queue nothing
+            for (std::size_t group = 0; group < processes.size(); group++)
+            {
+                if (!requests[group].empty())
+                    processes[group]->read_many(requests[group]);
+            }
+
+            std::size_t count {};
+            for (std::size_t i = 0; i < pointers.size(); i++)
+            {
+                // nothing queued means the address was bad
+                const auto& entry = queued[i];
+                if (entry.first == entry.last)
+                    continue;
+
+                pointers[i].finish(std::span(requests[entry.group]).subspan(entry.first, entry.last - entry.first));
+                count += pointers[i]._valid;
+            }
+
+            return count;
+        }
+
+        // the field as of the last fetch, fetching first when it wasn't read yet
+        template <typename U>
+        const U& get(U T::*member)
+        {
+            if (!_fetched || !recorded(offset_of(member), sizeof(U)))
+            {
+                field(member);
+                fetch();
+            }
+
+            return _value.*member;
+        }
+
+        // a pointer field as a RemotePtr of what it points to, an empty one when this has no process
+        template <typename U>
+        RemotePtr<U> follow(U* T::*member)
+        {
+            if (!_process)
+                return {};
+
+            return { *_process, gensokyo::Address(get(member)) };
+        }
+
+        // the same for pointers stored as integers, e.g of a 32 bit process
+        template <typename U, typename I>
+            requires std::is_integral_v<I>
+        RemotePtr<U> follow(I T::*member)
+        {
+            if (!_process)
+                return {};
+
+            return { *_process, gensokyo::Address(get(member)) };
+        }
+
+        const T* operator->()
+        {
+            if (!_fetched)
+                fetch();
+
+            return std::addressof(_value);
+        }
+
+        const T& operator*()
+        {
+            return *operator->();
+        }
+
+        // drop what was read, the next access reads again, e.g once per tick
+        void invalidate() noexcept
+        {
+            _fetched = false;
+        }
+
+        [[nodiscard]] gensokyo::Address address() const noexcept
+        {
+            return _address;
+        }
+
+        [[nodiscard]] bool fetched() const noexcept
+        {
+            return _fetched;
+        }
+
+        // whether the last fetch read every named field
+        [[nodiscard]] bool valid() const noexcept
+        {
+            return _valid;
+        }
+    };
+}
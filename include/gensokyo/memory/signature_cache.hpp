@@ -0,0 +1,85 @@
+#pragma once
+
+#include "address.hpp"
+#include "module.hpp"
+#include "pattern.hpp"
+#include "../helper/mapped_file.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+
+namespace gensokyo
+{
+    /*
+     * Remembers where patterns were found, keyed by module identity and pattern hash, in a memory mapped file
+     * A cached offset is only returned after the bytes there still match the pattern, so a stale or colliding entry costs a rescan and nothing else
+     * The file isn't locked, don't write to one cache from several processes at the same time
+     */
+    class SignatureCache
+    {
+      public:
+        static constexpr std::uint32_t magic   = 0x43534B47; // "GKSC"
+        static constexpr std::uint32_t version = 1;
+
+        struct Header
+        {
+            std::uint32_t magic;
+            std::uint32_t version;
+            std::uint64_t capacity;
+            std::uint64_t count;
+            std::uint64_t reserved;
+        };
+
+        // an unused slot has size 0, no module is empty
+        struct Entry
+        {
+            std::uint64_t build;
+            std::uint64_t size;
+            std::uint64_t pattern;
+            std::uint64_t offset;
+        };
+
+      private:
+        static constexpr std::uint64_t initial_capacity = 1024;
+
+        impl::MappedFile _file {};
+
+        [[nodiscard]] Header& header() const noexcept
+        {
+            return *reinterpret_cast<Header*>(_file.data());
+        }
+
+        [[nodiscard]] Entry* entries() const noexcept
+        {
+            return reinterpret_cast<Entry*>(_file.data() + sizeof(Header));
+        }
+
+        [[nodiscard]] Entry* slot(const impl::ModuleIdentity& module, std::uint64_t pattern) const noexcept;
+        void reset(std::uint64_t capacity);
+
+      public:
+        // opens or creates the cache file, a file from another version is cleared
+        explicit SignatureCache(const std::filesystem::path& path);
+
+        SignatureCache(const SignatureCache&)            = delete;
+        SignatureCache& operator=(const SignatureCache&) = delete;
+        SignatureCache(SignatureCache&&)                 = default;
+        SignatureCache& operator=(SignatureCache&&)      = default;
+
+        // offset from the module base, not validated
+        [[nodiscard]] std::optional<std::uintptr_t> lookup(const impl::ModuleIdentity& module, std::uint64_t pattern) const noexcept;
+        void store(const impl::ModuleIdentity& module, std::uint64_t pattern, std::uintptr_t offset);
+        void clear();
+
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            return header().count;
+        }
+
+        // hash of the bytes and masks of a pattern, never 0
+        [[nodiscard]] static std::uint64_t hash(pattern::impl::PatternView pattern) noexcept;
+
+        // the cached match when it still matches, otherwise scan the segments of the module and cache the result
+        gensokyo::Address find(impl::Module& module, pattern::impl::PatternView pattern);
+    };
+}
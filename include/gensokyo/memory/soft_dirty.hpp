@@ -0,0 +1,63 @@
+#pragma once
+
+#include "process.hpp"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace gensokyo::impl
+{
+    /*
+     * The soft-dirty page bits of another process, through /proc/<pid>/clear_refs and /proc/<pid>/pagemap
+     * clear() makes the kernel note every page the process writes to from then on, written() lists those pages
+     * The bits are shared by everything that clears them, only one tracker per process gets correct results
+     * Only on linux kernels with CONFIG_MEM_SOFT_DIRTY, is_open() is false everywhere else
+     */
+    class SoftDirty
+    {
+        std::intptr_t _clear_refs { -1 };
+        std::intptr_t _pagemap { -1 };
+
+        void close() noexcept;
+
+      public:
+        explicit SoftDirty(std::uint32_t pid);
+
+        SoftDirty(const SoftDirty&)            = delete;
+        SoftDirty& operator=(const SoftDirty&) = delete;
+
+        SoftDirty(SoftDirty&& other) noexcept
+         : _clear_refs(std::exchange(other._clear_refs, -1)),
+           _pagemap(std::exchange(other._pagemap, -1))
+        {
+        }
+
+        SoftDirty& operator=(SoftDirty&& other) noexcept
+        {
+            if (this != &other)
+            {
+                close();
+                _clear_refs = std::exchange(other._clear_refs, -1);
+                _pagemap    = std::exchange(other._pagemap, -1);
+            }
+
+            return *this;
+        }
+
+        ~SoftDirty()
+        {
+            close();
+        }
+
+        [[nodiscard]] bool is_open() const noexcept
+        {
+            return _clear_refs >= 0 && _pagemap >= 0;
+        }
+
+        // start noting writes from now on
+        bool clear();
+
+        // append the page aligned ranges overlapping region that were written since the last clear, false when pagemap can't be read
+        bool written(const MemoryRegion& region, std::vector<MemoryRegion>& ranges);
+    };
+}
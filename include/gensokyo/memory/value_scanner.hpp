@@ -0,0 +1,119 @@
+#pragma once
+
+#include "address.hpp"
+#include "process.hpp"
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace gensokyo
+{
+    enum class ScanCompare
+    {
+        Changed,
+        Unchanged,
+        Increased,
+        Decreased,
+    };
+
+    /*
+     * Finds addresses of a value in another process and narrows them down over several scans
+     * Values are looked for at offsets aligned to sizeof(T), floating point values are equal when they're within epsilon
+     *
+     * Candidates are kept per 4 KiB page, a page where every slot is a candidate only stores its values and other pages
+     * store a 16-bit slot index per candidate next to the value, so the cost is sizeof(T) + 2 bytes per candidate
+     * Next scans only read the pages that still have candidates, and of those only the bytes between the first and last one
+     *
+     * Not safe to use from several threads at the same time
+     */
+    template <typename T>
+    class ValueScanner
+    {
+        static_assert(std::is_arithmetic_v<T>, "ValueScanner only works on integers and floating point values");
+
+      public:
+        static constexpr std::size_t page_size      = 0x1000;
+        static constexpr std::size_t slots_per_page = page_size / sizeof(T);
+
+        struct Result
+        {
+            gensokyo::Address address {};
+            T value {};
+        };
+
+      private:
+        struct Page
+        {
+            std::uintptr_t address {};
+
+            // all slots when it's slots_per_page, _offsets has none for the page then
+            std::uint32_t count {};
+        };
+
+        impl::Process& _process;
+        impl::RegionFilter _filter {};
+        T _epsilon {};
+
+        // in address order, _offsets and _values are in the same order as the pages they belong to
+        std::vector<Page> _pages {};
+        std::vector<std::uint16_t> _offsets {};
+        std::vector<T> _values {};
+        std::size_t _count {};
+
+        [[nodiscard]] bool equal(T a, T b) const noexcept;
+
+        // keep the candidates for which keep(current, previous) is true, previous is replaced by current
+        template <typename F>
+        std::size_t narrow(F&& keep);
+
+      public:
+        /*
+         * @param filter Regions that are scanned, readable and writable memory like the heap by default
+         * @param epsilon Largest difference at which floating point values are still equal, unused for integers
+         */
+        explicit ValueScanner(impl::Process& process, impl::RegionFilter filter = { .readable = true, .writable = true }, T epsilon = {});
+
+        // every slot that holds value, returns the number of candidates
+        std::size_t first_scan(T value);
+
+        // every slot, for when the value isn't known yet, this keeps a copy of all scanned memory until the next scan
+        std::size_t first_scan_unknown();
+
+        // keep the candidates that hold value now
+        std::size_t next_scan(T value);
+
+        // keep the candidates whose value compares to the one of the previous scan like this
+        std::size_t next_scan(ScanCompare compare);
+
+        void reset();
+
+        [[nodiscard]] std::size_t count() const noexcept
+        {
+            return _count;
+        }
+
+        // bytes used for the candidates
+        [[nodiscard]] std::size_t memory_usage() const noexcept
+        {
+            return _pages.capacity() * sizeof(Page) + _offsets.capacity() * sizeof(std::uint16_t) + _values.capacity() * sizeof(T);
+        }
+
+        // calls func with every candidate and its value from the last scan, in address order, until it returns true
+        void for_each(const std::function<bool(gensokyo::Address address, T value)>& func) const;
+
+        [[nodiscard]] std::vector<Result> results(std::size_t max_count = std::numeric_limits<std::size_t>::max()) const;
+    };
+
+    extern template class ValueScanner<std::int8_t>;
+    extern template class ValueScanner<std::uint8_t>;
+    extern template class ValueScanner<std::int16_t>;
+    extern template class ValueScanner<std::uint16_t>;
+    extern template class ValueScanner<std::int32_t>;
+    extern template class ValueScanner<std::uint32_t>;
+    extern template class ValueScanner<std::int64_t>;
+    extern template class ValueScanner<std::uint64_t>;
+    extern template class ValueScanner<float>;
+    extern template class ValueScanner<double>;
+}
@@ -33,7 +33,14 @@ namespace gensokyo
 
         bool attached() override;
 
+        /*
+         * Call func for every committed region of the process behind handle in address order until it returns true
+         * Works with GetCurrentProcess() too, the handle needs PROCESS_QUERY_INFORMATION
+         */
+        static void for_each_mapping(HANDLE handle, const RegionCallbackFn& func);
+
       protected:
+        void enumerate_regions(const RegionCallbackFn& func) override;
         bool read_impl(std::uintptr_t address, void* buffer, std::size_t size) override;
         bool write_impl(std::uintptr_t address, void* buffer, std::size_t size) override;
         bool attach_by_process_name(std::string_view process_name) override;
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "process.hpp"
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace gensokyo
+{
+    /*
+     * Collects writes to another process and does them together with one write_many on flush()
+     * Values are copied when queued, writes to the same bytes are done in the order queued so the last one wins
+     */
+    class WriteQueue
+    {
+        struct Entry
+        {
+            std::uintptr_t address {};
+            std::size_t offset {};
+            std::size_t size {};
+        };
+
+        impl::Process& _process;
+        std::vector<std::uint8_t> _data {};
+        std::vector<Entry> _entries {};
+        std::vector<impl::WriteRequest> _requests {};
+
+      public:
+        explicit WriteQueue(impl::Process& process);
+
+        void write(std::uintptr_t address, const void* buffer, std::size_t size);
+
+        template <typename T>
+        void write(std::uintptr_t address, const T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "only plain values can be queued");
+            write(address, &value, sizeof(T));
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            return _entries.size();
+        }
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return _entries.empty();
+        }
+
+        // do every queued write and empty the queue, returns how many succeeded
+        std::size_t flush();
+        void clear();
+    };
+}
@@ -0,0 +1,221 @@
+#include <gensokyo.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+gensokyo::CachedProcess::CachedProcess(impl::Process& process, Clock::duration max_age, std::size_t max_pages)
+ : _process(process),
+   _max_age(max_age),
+   _max_pages(max_pages)
+{
+}
+
+bool gensokyo::CachedProcess::is_fresh(const Page& page, Clock::time_point now) const noexcept
+{
+    return page.generation == generation() && (_max_age == Clock::duration::zero() || now - page.fetched <= _max_age);
+}
+
+bool gensokyo::CachedProcess::copy_cached(std::uintptr_t page, std::size_t offset, void* buffer, std::size_t size, Clock::time_point now)
+{
+    std::shared_lock lock(_mutex);
+
+    const auto it = _pages.find(page);
+    if (it == _pages.end() || !is_fresh(it->second, now))
+        return false;
+
+    touch(it->second);
+    std::memcpy(buffer, it->second.data.data() + offset, size);
+    return true;
+}
+
+void gensokyo::CachedProcess::insert(std::uintptr_t page, const std::uint8_t* data, std::uint64_t generation, Clock::time_point fetched)
+{
+    std::unique_lock lock(_mutex);
+
+    if (_pages.size() >= _max_pages && !_pages.contains(page))
+    {
+        const auto now = Clock::now();
+        std::erase_if(_pages,
+                      [&](const auto& entry)
+                      {
+                          return !is_fresh(entry.second, now);
+                      });
+
+        if (_pages.size() >= _max_pages)
+        {
+            // drop an eighth at once rather than one page per insert, oldest use first
+            std::vector<std::pair<std::uint64_t, std::uintptr_t>> uses {};
+            uses.reserve(_pages.size());
+            for (const auto& [address, entry] : _pages)
+                uses.emplace_back(entry.used.load(std::memory_order_relaxed), address);
+
+            const auto keep  = _max_pages ? std::min(_max_pages - 1, _max_pages - _max_pages / 8) : 0;
+            const auto evict = uses.begin() + static_cast<std::ptrdiff_t>(uses.size() - keep);
+            std::ranges::nth_element(uses, evict);
+
+            for (auto it = uses.begin(); it != evict; ++it)
+                _pages.erase(it->second);
+        }
+    }
+
+    auto& entry      = _pages[page];
+    entry.generation = generation;
+    entry.fetched    = fetched;
+    touch(entry);
+    std::memcpy(entry.data.data(), data, page_size);
+}
+
+bool gensokyo::CachedProcess::read_pages(std::uintptr_t address, std::uint8_t* buffer, std::size_t size, bool count_stats)
+{
+    const auto now = Clock::now();
+
+    for (auto current = address; current < address + size;)
+    {
+        const auto page   = current & ~(page_size - 1);
+        const auto offset = current - page;
+        const auto count  = std::min(page_size - offset, address + size - current);
+        const auto output = buffer + (current - address);
+
+        if (copy_cached(page, offset, output, count, now))
+        {
+            if (count_stats)
+                _hits.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            if (count_stats)
+                _misses.fetch_add(1, std::memory_order_relaxed);
+
+            // taken before the read, an invalidate() while reading makes the page stale right away
+            const auto page_generation = generation();
+
+            std::array<std::uint8_t, page_size> data {};
+            if (!_process.read(page, data.data(), data.size()))
+            {
+                // only part of the page is mapped, read what was asked for without caching it
+                return _process.read(current, output, address + size - current);
+            }
+
+            insert(page, data.data(), page_generation, now);
+            std::memcpy(output, data.data() + offset, count);
+        }
+
+        current += count;
+    }
+
+    return true;
+}
+
+bool gensokyo::CachedProcess::read_impl(const std::uintptr_t address, void* buffer, const std::size_t size)
+{
+    return read_pages(address, static_cast<std::uint8_t*>(buffer), size, true);
+}
+
+void gensokyo::CachedProcess::read_many_impl(std::span<impl::ReadRequest> requests)
+{
+    const auto now = Clock::now();
+
+    // every page that is missing from the cache is fetched with a single read_many of the wrapped process
+    std::vector<std::uintptr_t> missing {};
+    {
+        std::shared_lock lock(_mutex);
+        for (const auto& request : requests)
+        {
+            for (auto page = request.address & ~(page_size - 1); page < request.address + request.size; page += page_size)
+            {
+                const auto it = _pages.find(page);
+                if (it != _pages.end() && is_fresh(it->second, now))
+                {
+                    touch(it->second);
+                    _hits.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+
+                _misses.fetch_add(1, std::memory_order_relaxed);
+                missing.push_back(page);
+            }
+        }
+    }
+
+    std::ranges::sort(missing);
+    const auto duplicates = std::ranges::unique(missing);
+    missing.erase(duplicates.begin(), duplicates.end());
+
+    std::vector<std::uint8_t> data(missing.size() * page_size);
+    std::vector<impl::ReadRequest> fetches {};
+    fetches.reserve(missing.size());
+    for (std::size_t i = 0; i < missing.size(); i++)
+        fetches.push_back({ missing[i], data.data() + i * page_size, page_size });
+
+    if (!fetches.empty())
+    {
+        const auto page_generation = generation();
+        _process.read_many(fetches);
+
+        for (const auto& fetch : fetches)
+        {
+            if (fetch.success)
+                insert(fetch.address, static_cast<const std::uint8_t*>(fetch.buffer), page_generation, now);
+        }
+    }
+
+    // served from the fetched pages rather than the cache, a batch bigger than the cache evicts its own pages
+    for (auto& request : requests)
+    {
+        const auto output = static_cast<std::uint8_t*>(request.buffer);
+        const auto end    = request.address + request.size;
+
+        request.success = true;
+        for (auto current = request.address; current < end && request.success;)
+        {
+            const auto page   = current & ~(page_size - 1);
+            const auto offset = current - page;
+            const auto count  = std::min(page_size - offset, end - current);
+
+            const auto fetched = std::ranges::lower_bound(missing, page);
+            if (fetched == missing.end() || *fetched != page)
+            {
+                // a hit above, read_pages fetches it again if it has been evicted since
+                request.success = read_pages(current, output + (current - request.address), count, false);
+            }
+            else if (const auto& fetch = fetches[static_cast<std::size_t>(fetched - missing.begin())]; fetch.success)
+                std::memcpy(output + (current - request.address), static_cast<const std::uint8_t*>(fetch.buffer) + offset, count);
+            else
+            {
+                // only part of the page is mapped, read what was asked for without caching it
+                request.success = _process.read(current, output + (current - request.address), end - current);
+                break;
+            }
+
+            current += count;
+        }
+    }
+}
+
+bool gensokyo::CachedProcess::write_impl(const std::uintptr_t address, void* buffer, const std::size_t size)
+{
+    const auto written = _process.write(address, buffer, size);
+
+    std::unique_lock lock(_mutex);
+    for (auto page = address & ~(page_size - 1); page < address + size; page += page_size)
+    {
+        const auto it = _pages.find(page);
+        if (it == _pages.end())
+            continue;
+
+        // a failed write may have changed some of the bytes, read the page again next time
+        if (!written)
+        {
+            _pages.erase(it);
+            continue;
+        }
+
+        const auto begin = std::max(page, address);
+        const auto end   = std::min(page + page_size, address + size);
+        std::memcpy(it->second.data.data() + (begin - page), static_cast<const std::uint8_t*>(buffer) + (begin - address), end - begin);
+    }
+
+    return written;
+}
@@ -0,0 +1,128 @@
+#include <gensokyo.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+gensokyo::Freezer::Freezer(impl::Process& process, Clock::duration interval)
+ : _process(process),
+   _interval(interval)
+{
+}
+
+std::size_t gensokyo::Freezer::freeze(std::uintptr_t address, const void* buffer, std::size_t size)
+{
+    std::call_once(_started,
+                   [this]
+                   {
+                       _thread = std::jthread(
+                         [this](std::stop_token token)
+                         {
+                             run(std::move(token));
+                         });
+                   });
+
+    std::size_t id {};
+    {
+        std::lock_guard lock(_mutex);
+        std::erase_if(_frozen,
+                      [&](const Frozen& frozen)
+                      {
+                          return frozen.address == address;
+                      });
+
+        const auto* bytes = static_cast<const std::uint8_t*>(buffer);
+        id                = _next_id++;
+        _frozen.push_back({ id, address, { bytes, bytes + size } });
+        _changed = true;
+    }
+
+    _cv.notify_one();
+    return id;
+}
+
+bool gensokyo::Freezer::unfreeze(std::size_t id)
+{
+    std::lock_guard lock(_mutex);
+    const auto removed = std::erase_if(_frozen,
+                                       [&](const Frozen& frozen)
+                                       {
+                                           return frozen.id == id;
+                                       });
+
+    _changed |= removed != 0;
+    return removed != 0;
+}
+
+void gensokyo::Freezer::clear()
+{
+    std::lock_guard lock(_mutex);
+    _frozen.clear();
+    _changed = true;
+}
+
+std::size_t gensokyo::Freezer::size()
+{
+    std::lock_guard lock(_mutex);
+    return _frozen.size();
+}
+
+void gensokyo::Freezer::set_interval(Clock::duration interval)
+{
+    {
+        std::lock_guard lock(_mutex);
+        _interval   = interval;
+        _reschedule = true;
+    }
+
+    // a long wait shouldn't hold up a shorter interval, the next round starts now
+    _cv.notify_one();
+}
+
+std::size_t gensokyo::Freezer::apply()
+{
+    std::lock_guard lock(_mutex);
+    return apply_locked();
+}
+
+std::size_t gensokyo::Freezer::apply_locked()
+{
+    if (_changed)
+    {
+        _requests.clear();
+        for (const auto& frozen : _frozen)
+            _requests.push_back({ frozen.address, frozen.value.data(), frozen.value.size() });
+
+        _changed = false;
+    }
+
+    if (_requests.empty())
+        return 0;
+
+    return _process.write_many(_requests);
+}
+
+void gensokyo::Freezer::run(std::stop_token token)
+{
+    std::unique_lock lock(_mutex);
+
+    // sleeps while nothing is frozen, the wait returns the predicate when stopped so check that too
+    while (_cv.wait(lock, token,
+                    [this]
+                    {
+                        return !_frozen.empty();
+                    })
+           && !token.stop_requested())
+    {
+        const auto start = Clock::now();
+        apply_locked();
+        _rounds.fetch_add(1, std::memory_order_relaxed);
+
+        // the schedule counts from the start of the round, so the time the write takes isn't added on top
+        _reschedule = false;
+        _cv.wait_until(lock, token, start + _interval,
+                       [this]
+                       {
+                           return _reschedule;
+                       });
+    }
+}
@@ -1 +1,374 @@
-// TODO: Finish this
\ No newline at end of file
+#include <gensokyo.hpp>
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <climits>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace
+{
+    // one line of /proc/<pid>/maps, path reuses the storage of the previous region
+    bool parse_mapping(std::string_view line, gensokyo::impl::Region& region)
+    {
+        // 55d4c5a00000-55d4c5a28000 r-xp 00000000 08:01 1234    /usr/bin/bash
+        const auto* end = line.data() + line.size();
+
+        std::uintptr_t start {};
+        std::uintptr_t stop {};
+        auto result = std::from_chars(line.data(), end, start, 16);
+        if (result.ec != std::errc {} || result.ptr == end || *result.ptr != '-')
+            return false;
+
+        result = std::from_chars(result.ptr + 1, end, stop, 16);
+        if (result.ec != std::errc {} || end - result.ptr < 5 || stop < start)
+            return false;
+
+        const auto* perms = result.ptr + 1;
+        region.address    = start;
+        region.size       = stop - start;
+        region.readable   = perms[0] == 'r';
+        region.writable   = perms[1] == 'w';
+        region.executable = perms[2] == 'x';
+
+        // offset, device and inode, the path is the rest of the line after the padding
+        auto rest = std::string_view(perms + 4, end);
+        std::string_view inode {};
+        for (auto i = 0; i < 3; i++)
+        {
+            rest.remove_prefix(std::min(rest.find_first_not_of(' '), rest.size()));
+            inode = rest.substr(0, rest.find(' '));
+            rest.remove_prefix(inode.size());
+
+            if (i == 0)
+                std::from_chars(inode.data(), inode.data() + inode.size(), region.offset, 16);
+        }
+
+        rest.remove_prefix(std::min(rest.find_first_not_of(' '), rest.size()));
+        region.path.assign(rest);
+        region.image = inode != "0" && !rest.empty() && rest.front() == '/';
+        return true;
+    }
+
+    // start of the first readable mapping, used to find out which access method works
+    std::optional<std::uintptr_t> readable_address(std::uint32_t pid)
+    {
+        std::optional<std::uintptr_t> address {};
+        gensokyo::LinuxProcess::for_each_mapping(pid,
+                                                 [&](const gensokyo::impl::Region& region)
+                                                 {
+                                                     if (region.readable)
+                                                         address = region.address;
+
+                                                     return region.readable;
+                                                 });
+
+        return address;
+    }
+
+    template <typename F>
+    bool transfer_all(F&& func, std::uintptr_t address, std::uint8_t* buffer, std::size_t size)
+    {
+        while (size)
+        {
+            const auto count = func(buffer, size, static_cast<off_t>(address));
+            if (count <= 0)
+                return false;
+
+            address += count;
+            buffer += count;
+            size -= count;
+        }
+
+        return true;
+    }
+
+    /*
+     * Hand requests to process_vm_readv or process_vm_writev, IOV_MAX at a time
+     * A call stops at the first remote range that fails and everything before it is done, so it goes on after that one
+     */
+    template <typename Request, typename F>
+    void transfer_many(std::span<Request> requests, F&& func)
+    {
+        std::vector<iovec> local {};
+        std::vector<iovec> remote {};
+
+        for (std::size_t first = 0; first < requests.size();)
+        {
+            const auto count = std::min<std::size_t>(requests.size() - first, IOV_MAX);
+
+            local.clear();
+            remote.clear();
+            for (auto i = first; i < first + count; i++)
+            {
+                local.push_back({ const_cast<void*>(requests[i].buffer), requests[i].size });
+                remote.push_back({ reinterpret_cast<void*>(requests[i].address), requests[i].size });
+            }
+
+            auto transferred = func(local.data(), remote.data(), count);
+            if (transferred < 0)
+            {
+                // only a bad first range is worth going on after, the process being gone isn't
+                if (errno != EFAULT)
+                    return;
+
+                transferred = 0;
+            }
+
+            auto i = first;
+            for (; i < first + count && static_cast<std::size_t>(transferred) >= requests[i].size; i++)
+            {
+                requests[i].success = true;
+                transferred -= static_cast<ssize_t>(requests[i].size);
+            }
+
+            // skip the request that stopped it and go on with the next one
+            first = i < first + count ? i + 1 : i;
+        }
+    }
+}
+
+gensokyo::LinuxProcess::LinuxProcess(std::string_view process_name)
+{
+    if (!LinuxProcess::attach_by_process_name(process_name))
+        throw std::runtime_error("Failed to attach to process");
+}
+
+gensokyo::LinuxProcess::LinuxProcess(std::uint32_t pid)
+{
+    attach(pid);
+}
+
+gensokyo::LinuxProcess::~LinuxProcess()
+{
+    if (_mem >= 0)
+        close(_mem);
+}
+
+void gensokyo::LinuxProcess::attach(std::uint32_t pid)
+{
+    const auto probe = readable_address(pid);
+    if (!probe)
+        throw std::runtime_error("Failed to attach to process");
+
+    std::uint8_t byte {};
+
+    // a single read tells whether the syscall exists and whether we're allowed to use it on this process
+    iovec local { &byte, 1 };
+    iovec remote { reinterpret_cast<void*>(*probe), 1 };
+    if (process_vm_readv(static_cast<pid_t>(pid), &local, 1, &remote, 1, 0) == 1)
+    {
+        _pid    = pid;
+        _method = AccessMethod::VmReadv;
+        return;
+    }
+
+    auto mem = open(fmt::format("/proc/{}/mem", pid).c_str(), O_RDWR | O_CLOEXEC);
+    if (mem < 0)
+        mem = open(fmt::format("/proc/{}/mem", pid).c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (mem < 0 || pread(mem, &byte, 1, static_cast<off_t>(*probe)) != 1)
+    {
+        if (mem >= 0)
+            close(mem);
+
+        throw std::runtime_error("Failed to attach to process");
+    }
+
+    _pid    = pid;
+    _mem    = mem;
+    _method = AccessMethod::ProcMem;
+}
+
+bool gensokyo::LinuxProcess::attached()
+{
+    return _pid != 0 && _method != AccessMethod::None;
+}
+
+// parse through a fixed buffer, it's polled often so nothing but the path is allocated
+bool gensokyo::LinuxProcess::for_each_mapping(std::uint32_t pid, const RegionCallbackFn& func)
+{
+    const auto fd = open(fmt::format("/proc/{}/maps", pid).c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+    // a line is at most PATH_MAX plus the fixed fields
+    std::array<char, 4 * PATH_MAX> buffer {};
+    std::size_t used {};
+    impl::Region region {};
+
+    for (auto done = false; !done;)
+    {
+        const auto count = ::read(fd, buffer.data() + used, buffer.size() - used);
+        if (count < 0 && errno == EINTR)
+            continue;
+
+        if (count <= 0)
+            break;
+
+        used += static_cast<std::size_t>(count);
+
+        std::size_t begin {};
+        while (!done)
+        {
+            const auto* newline = static_cast<const char*>(std::memchr(buffer.data() + begin, '\n', used - begin));
+            if (!newline)
+                break;
+
+            const auto line = std::string_view(buffer.data() + begin, newline);
+            begin           = static_cast<std::size_t>(newline - buffer.data()) + 1;
+
+            if (parse_mapping(line, region))
+                done = func(region);
+        }
+
+        // keep the partial line for the next read
+        std::memmove(buffer.data(), buffer.data() + begin, used - begin);
+        used -= begin;
+    }
+
+    ::close(fd);
+    return true;
+}
+
+void gensokyo::LinuxProcess::enumerate_regions(const RegionCallbackFn& func)
+{
+    for_each_mapping(_pid, func);
+}
+
+bool gensokyo::LinuxProcess::read_impl(const std::uintptr_t address, void* buffer, const std::size_t size)
+{
+    if (_method == AccessMethod::VmReadv)
+    {
+        iovec local { buffer, size };
+        iovec remote { reinterpret_cast<void*>(address), size };
+        return process_vm_readv(static_cast<pid_t>(_pid), &local, 1, &remote, 1, 0) == static_cast<ssize_t>(size);
+    }
+
+    if (_method == AccessMethod::ProcMem)
+    {
+        return transfer_all(
+          [this](std::uint8_t* data, std::size_t count, off_t offset)
+          {
+              return pread(_mem, data, count, offset);
+          },
+          address, static_cast<std::uint8_t*>(buffer), size);
+    }
+
+    return false;
+}
+
+void gensokyo::LinuxProcess::read_many_impl(std::span<impl::ReadRequest> requests)
+{
+    // pread can't gather, merging nearby requests is the best it gets
+    if (_method != AccessMethod::VmReadv)
+    {
+        Process::read_many_impl(requests);
+        return;
+    }
+
+    transfer_many(requests,
+                  [this](const iovec* local, const iovec* remote, std::size_t count)
+                  {
+                      return process_vm_readv(static_cast<pid_t>(_pid), local, count, remote, count, 0);
+                  });
+}
+
+bool gensokyo::LinuxProcess::write_impl(const std::uintptr_t address, void* buffer, const std::size_t size)
+{
+    if (_method == AccessMethod::VmReadv)
+    {
+        iovec local { buffer, size };
+        iovec remote { reinterpret_cast<void*>(address), size };
+        const auto written = process_vm_writev(static_cast<pid_t>(_pid), &local, 1, &remote, 1, 0);
+        if (written == static_cast<ssize_t>(size))
+            return true;
+
+        // stopped at a page it isn't allowed to write, a partial write sets no errno, writing the whole range again is harmless
+        return (written >= 0 || errno == EFAULT) && write_mem(address, buffer, size);
+    }
+
+    return _method == AccessMethod::ProcMem && write_mem(address, buffer, size);
+}
+
+bool gensokyo::LinuxProcess::write_mem(const std::uintptr_t address, void* buffer, const std::size_t size)
+{
+    std::call_once(_mem_opened,
+                   [this]
+                   {
+                       if (_mem < 0)
+                           _mem = open(fmt::format("/proc/{}/mem", _pid).c_str(), O_RDWR | O_CLOEXEC);
+                   });
+
+    if (_mem < 0)
+        return false;
+
+    return transfer_all(
+      [this](std::uint8_t* data, std::size_t count, off_t offset)
+      {
+          return pwrite(_mem, data, count, offset);
+      },
+      address, static_cast<std::uint8_t*>(buffer), size);
+}
+
+void gensokyo::LinuxProcess::write_many_impl(std::span<impl::WriteRequest> requests)
+{
+    if (_method != AccessMethod::VmReadv)
+    {
+        Process::write_many_impl(requests);
+        return;
+    }
+
+    // the ranges are written in order, where they overlap the later one wins like in the merged writes
+    transfer_many(requests,
+                  [this](const iovec* local, const iovec* remote, std::size_t count)
+                  {
+                      return process_vm_writev(static_cast<pid_t>(_pid), local, count, remote, count, 0);
+                  });
+
+    // the ones on read-only pages go through the file, in order so overlapping writes still end the same
+    for (auto& request : requests)
+    {
+        if (!request.success)
+            request.success = write_mem(request.address, const_cast<void*>(request.buffer), request.size);
+    }
+}
+
+bool gensokyo::LinuxProcess::attach_by_process_name(std::string_view process_name)
+{
+    std::error_code error {};
+    for (const auto& entry : std::filesystem::directory_iterator("/proc", error))
+    {
+        const auto name = entry.path().filename().string();
+
+        std::uint32_t pid {};
+        if (std::from_chars(name.data(), name.data() + name.size(), pid).ptr != name.data() + name.size())
+            continue;
+
+        // comm is cut to 15 characters, the executable path has the full name
+        std::string comm {};
+        std::getline(std::ifstream(entry.path() / "comm"), comm);
+
+        const auto exe = std::filesystem::read_symlink(entry.path() / "exe", error).filename().string();
+        if (comm != process_name && exe != process_name)
+            continue;
+
+        try
+        {
+            attach(pid);
+            return true;
+        }
+        catch (const std::runtime_error&)
+        {
+            // most likely a process of another user, keep looking
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,25 @@
+#include <gensokyo.hpp>
+
+#include <unistd.h>
+
+std::uint32_t gensokyo::LocalProcess::get_pid()
+{
+    return static_cast<std::uint32_t>(getpid());
+}
+
+void gensokyo::LocalProcess::enumerate_regions(const RegionCallbackFn& func)
+{
+    LinuxProcess::for_each_mapping(get_pid(),
+                                   [&](const impl::Region& region)
+                                   {
+                                       // the vdso data pages say r but some of them fault when touched
+                                       if (region.path.starts_with("[vvar"))
+                                       {
+                                           auto hidden     = region;
+                                           hidden.readable = false;
+                                           return func(hidden);
+                                       }
+
+                                       return func(region);
+                                   });
+}
@@ -0,0 +1,74 @@
+#include <gensokyo.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <stdexcept>
+
+gensokyo::impl::MappedFile::MappedFile(const std::filesystem::path& path, std::size_t min_size)
+{
+    _file = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (_file < 0)
+        throw std::runtime_error(fmt::format("Failed to open {}", path.string()));
+
+    struct stat file {};
+    if (fstat(static_cast<int>(_file), &file) != 0)
+    {
+        close();
+        throw std::runtime_error(fmt::format("Failed to stat {}", path.string()));
+    }
+
+    try
+    {
+        resize(std::max(static_cast<std::size_t>(file.st_size), min_size));
+    }
+    catch (...)
+    {
+        close();
+        throw;
+    }
+}
+
+void gensokyo::impl::MappedFile::map(std::size_t size)
+{
+    const auto data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, static_cast<int>(_file), 0);
+    if (data == MAP_FAILED)
+        throw std::runtime_error("Failed to map file");
+
+    _data = static_cast<std::uint8_t*>(data);
+    _size = size;
+}
+
+void gensokyo::impl::MappedFile::unmap() noexcept
+{
+    if (_data)
+        munmap(_data, _size);
+
+    _data = nullptr;
+    _size = 0;
+}
+
+void gensokyo::impl::MappedFile::resize(std::size_t size)
+{
+    if (_file < 0)
+        throw std::runtime_error("Resizing a closed file");
+
+    unmap();
+
+    if (ftruncate(static_cast<int>(_file), static_cast<off_t>(size)) != 0)
+        throw std::runtime_error("Failed to resize file");
+
+    if (size)
+        map(size);
+}
+
+void gensokyo::impl::MappedFile::close() noexcept
+{
+    unmap();
+
+    if (_file >= 0)
+        ::close(static_cast<int>(_file));
+
+    _file = -1;
+}
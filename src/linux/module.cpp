@@ -1 +1,365 @@
-// TODO: Finish this
\ No newline at end of file
+#include <gensokyo.hpp>
+
+#include <dlfcn.h>
+#include <elf.h>
+#include <link.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <stdexcept>
+
+namespace
+{
+    // only modules of the same class as this build, the headers are read into the native structs
+    constexpr auto elf_class = sizeof(void*) == 8 ? ELFCLASS64 : ELFCLASS32;
+
+    struct ModuleSearch
+    {
+        std::string_view name {};
+        // the info itself only lives during the callback, the program headers it points to live with the module
+        std::optional<dl_phdr_info> info {};
+        std::string path {};
+    };
+
+    // an empty name is the main program, otherwise match the file name with or without its version suffix
+    bool name_matches(std::string_view path, std::string_view name)
+    {
+        const auto file_name = std::string_view(path).substr(path.find_last_of('/') + 1);
+        return file_name == name || (file_name.starts_with(name) && file_name.size() > name.size() && file_name[name.size()] == '.');
+    }
+
+    std::uint64_t fnv1a(const std::uint8_t* data, std::size_t size, std::uint64_t hash = 0xCBF29CE484222325)
+    {
+        for (std::size_t i = 0; i < size; i++)
+            hash = (hash ^ data[i]) * 0x100000001B3;
+
+        return hash;
+    }
+
+    // hash of the NT_GNU_BUILD_ID note among the notes in [note, end), 0 when there's none
+    std::uint64_t note_build_id(const std::uint8_t* note, const std::uint8_t* end)
+    {
+        // the sizes may come from another process, they're checked against what's left before a pointer is made from them
+        for (auto left = static_cast<std::size_t>(end - note); left >= sizeof(ElfW(Nhdr));)
+        {
+            ElfW(Nhdr) nhdr {};
+            std::memcpy(&nhdr, note, sizeof(nhdr));
+            left -= sizeof(nhdr);
+
+            const auto name_size = (static_cast<std::size_t>(nhdr.n_namesz) + 3) & ~std::size_t { 3 };
+            const auto desc_size = (static_cast<std::size_t>(nhdr.n_descsz) + 3) & ~std::size_t { 3 };
+            if (name_size > left || nhdr.n_descsz > left - name_size)
+                return 0;
+
+            const auto name = note + sizeof(nhdr);
+            const auto desc = name + name_size;
+            if (nhdr.n_type == NT_GNU_BUILD_ID && nhdr.n_namesz == 4 && std::memcmp(name, "GNU", 4) == 0)
+                return fnv1a(desc, nhdr.n_descsz);
+
+            // the padding of the last note may be cut off
+            if (desc_size > left - name_size)
+                return 0;
+
+            note = desc + desc_size;
+            left -= name_size + desc_size;
+        }
+
+        return 0;
+    }
+
+    // hash of the NT_GNU_BUILD_ID note, 0 when the module was linked without one
+    std::uint64_t build_id(const dl_phdr_info* info)
+    {
+        for (auto i = 0; i < info->dlpi_phnum; i++)
+        {
+            const auto& header = info->dlpi_phdr[i];
+            if (header.p_type != PT_NOTE)
+                continue;
+
+            const auto note = reinterpret_cast<const std::uint8_t*>(info->dlpi_addr + header.p_vaddr);
+            if (const auto build = note_build_id(note, note + header.p_memsz))
+                return build;
+        }
+
+        return 0;
+    }
+
+    // no build-id, fall back to the file on disk which changes whenever the module is replaced
+    std::uint64_t file_id(const char* path)
+    {
+        struct stat file {};
+        if (stat(path, &file) != 0)
+            return 0;
+
+        const std::uint64_t fields[] = { static_cast<std::uint64_t>(file.st_ino), static_cast<std::uint64_t>(file.st_mtim.tv_sec), static_cast<std::uint64_t>(file.st_mtim.tv_nsec),
+                                         static_cast<std::uint64_t>(file.st_size) };
+        return fnv1a(reinterpret_cast<const std::uint8_t*>(fields), sizeof(fields));
+    }
+}
+
+gensokyo::impl::Module::Module(const std::string_view str, const FunctionCallbackFn& func)
+{
+    get_module_nfo(str, func);
+}
+
+void gensokyo::impl::Module::get_module_nfo(std::string_view mod, const FunctionCallbackFn& func)
+{
+    ModuleSearch search { mod };
+
+    dl_iterate_phdr(
+      [](dl_phdr_info* info, std::size_t, void* user) -> int
+      {
+          const auto state = static_cast<ModuleSearch*>(user);
+          const auto path  = info->dlpi_name ? std::string_view(info->dlpi_name) : std::string_view {};
+
+          // the main program is always reported first and without a name
+          if (state->name.empty() ? path.empty() : name_matches(path, state->name))
+          {
+              state->info = *info;
+              state->path = path;
+              return 1;
+          }
+
+          return 0;
+      },
+      &search);
+
+    if (!search.info)
+        throw std::runtime_error("Failed to get module handle");
+
+    const auto info = &*search.info;
+
+    std::uintptr_t lowest  = UINTPTR_MAX;
+    std::uintptr_t highest = 0;
+
+    for (auto i = 0; i < info->dlpi_phnum; i++)
+    {
+        const auto& header = info->dlpi_phdr[i];
+        if (header.p_type != PT_LOAD)
+            continue;
+
+        lowest  = std::min<std::uintptr_t>(lowest, header.p_vaddr);
+        highest = std::max<std::uintptr_t>(highest, header.p_vaddr + header.p_memsz);
+    }
+
+    if (lowest > highest)
+        throw std::runtime_error("Module has no loadable segments");
+
+    // RTLD_NOLOAD still takes a reference, the last copy of this gives it back
+    if (const auto handle = dlopen(search.path.empty() ? nullptr : search.path.c_str(), RTLD_LAZY | RTLD_NOLOAD))
+        this->_handle = std::shared_ptr<void>(handle, dlclose);
+
+    this->_baseAddress = info->dlpi_addr + lowest;
+    this->_size        = highest - lowest;
+
+    for (auto i = 0; i < info->dlpi_phnum; i++)
+    {
+        const auto& header = info->dlpi_phdr[i];
+
+        const auto is_executable = (header.p_flags & PF_X) != 0;
+
+        if (const auto is_readable = (header.p_flags & PF_R) != 0; header.p_type == PT_LOAD && is_executable && is_readable)
+        {
+            const auto start = info->dlpi_addr + header.p_vaddr;
+            const auto size  = std::min(header.p_filesz, header.p_memsz);
+
+            this->_segments.emplace_back(start, reinterpret_cast<std::uint8_t*>(start), size);
+        }
+    }
+
+    auto build = build_id(info);
+    if (!build)
+        build = file_id(search.path.empty() ? "/proc/self/exe" : search.path.c_str());
+
+    this->_identity = { build, _size };
+
+    logger.success("{} | base_addr:{:#05x} | size:{:#05x} | _segments.size():{}", mod, _baseAddress, _size, _segments.size());
+
+    if (func)
+    {
+        // gaps between the loaded segments may not be mapped, only copy what is
+        std::vector<std::uint8_t> data(_size);
+        for (auto i = 0; i < info->dlpi_phnum; i++)
+        {
+            const auto& header = info->dlpi_phdr[i];
+            if (header.p_type != PT_LOAD || !(header.p_flags & PF_R))
+                continue;
+
+            const auto start = reinterpret_cast<const std::uint8_t*>(info->dlpi_addr + header.p_vaddr);
+            std::copy_n(start, header.p_memsz, data.begin() + (header.p_vaddr - lowest));
+        }
+
+        func(data);
+    }
+}
+
+void* gensokyo::impl::Module::get_proc(const std::string_view proc_name)
+{
+    if (!this->_handle)
+        throw std::runtime_error("Invalid module handle when getting ProcAddress");
+
+    if (const auto address = dlsym(_handle.get(), std::string(proc_name).c_str()); address)
+    {
+        return address;
+    }
+
+    throw std::runtime_error(fmt::format("Cannot get proc with name {}", proc_name));
+}
+
+std::vector<bool> gensokyo::impl::Process::read_module_headers(std::span<ModuleInfo> modules)
+{
+    // the elf header and almost always the program headers are in the first page
+    constexpr std::size_t header_size = 0x1000;
+    constexpr std::size_t max_notes   = 0x1000;
+
+    std::vector<bool> parsed(modules.size());
+    std::vector<std::uint8_t> pages(modules.size() * header_size);
+    std::vector<ReadRequest> requests {};
+    for (std::size_t i = 0; i < modules.size(); i++)
+        requests.push_back({ modules[i].base, pages.data() + i * header_size, std::min(header_size, modules[i].size) });
+
+    read_many(requests);
+
+    std::vector<std::vector<ElfW(Phdr)>> tables(modules.size());
+    std::vector<ReadRequest> table_requests {};
+    std::vector<std::size_t> owners {};
+    for (std::size_t i = 0; i < modules.size(); i++)
+    {
+        // anything else mapped from a file, fonts, locale archives and such, isn't a module
+        ElfW(Ehdr) header {};
+        if (!requests[i].success || requests[i].size < sizeof(header))
+            continue;
+
+        std::memcpy(&header, requests[i].buffer, sizeof(header));
+        if (std::memcmp(header.e_ident, ELFMAG, SELFMAG) != 0 || header.e_ident[EI_CLASS] != elf_class || header.e_phentsize != sizeof(ElfW(Phdr)) ||
+            header.e_phnum == 0)
+            continue;
+
+        auto& table      = tables[i];
+        table.resize(header.e_phnum);
+        const auto bytes = table.size() * sizeof(ElfW(Phdr));
+
+        if (header.e_phoff + bytes <= requests[i].size)
+            std::memcpy(table.data(), static_cast<const std::uint8_t*>(requests[i].buffer) + header.e_phoff, bytes);
+        else
+        {
+            table_requests.push_back({ modules[i].base + header.e_phoff, table.data(), bytes });
+            owners.push_back(i);
+        }
+    }
+
+    if (!table_requests.empty())
+    {
+        read_many(table_requests);
+        for (std::size_t i = 0; i < table_requests.size(); i++)
+        {
+            if (!table_requests[i].success)
+                tables[owners[i]].clear();
+        }
+    }
+
+    // the paths are in the mount namespace of the process, which may be a container with its own root
+    const auto root = get_pid() ? fmt::format("/proc/{}/root", get_pid()) : std::string {};
+
+    std::error_code error {};
+    const auto program = get_pid() ? std::filesystem::read_symlink(fmt::format("/proc/{}/exe", get_pid()), error).string() : std::string {};
+
+    std::vector<std::vector<std::uint8_t>> notes(modules.size());
+    std::vector<ReadRequest> note_requests {};
+    owners.clear();
+
+    for (std::size_t i = 0; i < modules.size(); i++)
+    {
+        const auto& table = tables[i];
+        auto& module      = modules[i];
+
+        const ElfW(Phdr)* first {};
+        std::uintptr_t highest = 0;
+        for (const auto& header : table)
+        {
+            if (header.p_type != PT_LOAD)
+                continue;
+
+            if (!first || header.p_vaddr < first->p_vaddr)
+                first = &header;
+
+            highest = std::max<std::uintptr_t>(highest, header.p_vaddr + header.p_memsz);
+        }
+
+        if (!first)
+            continue;
+
+        // all notes of a module in one buffer, they're parsed one segment at a time below
+        std::size_t size {};
+        for (const auto& header : table)
+            size += header.p_type == PT_NOTE ? std::min<std::size_t>(header.p_memsz, max_notes + 1) : 0;
+
+        // the sizes come from the other process, a build-id is a few dozen bytes so a module with more than that is broken or lying
+        if (size > max_notes)
+            continue;
+
+        /*
+         * The elf header was read at the base, so the first mapping starts at file offset 0
+         * A segment is mapped with its address and file offset the same distance apart, whatever the page size, that gives the bias
+         */
+        const auto lowest = static_cast<std::uintptr_t>(first->p_vaddr);
+        const auto bias   = module.base - (first->p_vaddr - first->p_offset);
+
+        module.base = bias + lowest;
+        module.size = highest - lowest;
+
+        // libc has an interpreter too, so go by the file the kernel started when it's known
+        module.program  = program.empty() ? std::ranges::any_of(table,
+                                                               [](const ElfW(Phdr)& header)
+                                                               {
+                                                                   return header.p_type == PT_INTERP;
+                                                               })
+                                          : module.path == program;
+
+        for (const auto& header : table)
+        {
+            if (header.p_type == PT_LOAD && (header.p_flags & PF_X) && (header.p_flags & PF_R))
+                module.code.push_back({ bias + header.p_vaddr, std::min(header.p_filesz, header.p_memsz) });
+        }
+
+        notes[i].resize(size);
+        for (std::size_t offset = 0; const auto& header : table)
+        {
+            if (header.p_type != PT_NOTE)
+                continue;
+
+            note_requests.push_back({ bias + header.p_vaddr, notes[i].data() + offset, header.p_memsz });
+            owners.push_back(i);
+            offset += header.p_memsz;
+        }
+
+        parsed[i] = true;
+    }
+
+    read_many(note_requests);
+
+    for (std::size_t i = 0; i < note_requests.size(); i++)
+    {
+        auto& identity = modules[owners[i]].identity;
+        if (identity.build || !note_requests[i].success)
+            continue;
+
+        const auto* note = static_cast<const std::uint8_t*>(note_requests[i].buffer);
+        identity.build   = note_build_id(note, note + note_requests[i].size);
+    }
+
+    for (std::size_t i = 0; i < modules.size(); i++)
+    {
+        if (!parsed[i])
+            continue;
+
+        if (!modules[i].identity.build)
+            modules[i].identity.build = file_id((root + modules[i].path).c_str());
+
+        modules[i].identity.size = modules[i].size;
+    }
+
+    return parsed;
+}
@@ -0,0 +1,120 @@
+#include <gensokyo.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace
+{
+    constexpr std::uint64_t soft_dirty_bit = 1ull << 55;
+
+    // "4" clears the soft-dirty bits of every page, the numbers below it clear the accessed bits
+    bool clear_soft_dirty(int clear_refs)
+    {
+        return write(clear_refs, "4", 1) == 1;
+    }
+
+    std::size_t page_size()
+    {
+        static const auto size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        return size;
+    }
+
+    /*
+     * Without CONFIG_MEM_SOFT_DIRTY clear_refs takes the "4" but pagemap never sets the bit, which would look like nothing is ever written
+     * Write to a page of our own after clearing and see if it shows up, this clears our own bits once as well
+     */
+    bool kernel_supports_soft_dirty()
+    {
+        static const auto supported = []
+        {
+            const auto clear_refs = open("/proc/self/clear_refs", O_WRONLY | O_CLOEXEC);
+            const auto pagemap    = open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC);
+            auto* page            = mmap(nullptr, page_size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+            auto result = false;
+            if (clear_refs >= 0 && pagemap >= 0 && page != MAP_FAILED)
+            {
+                static_cast<volatile std::uint8_t*>(page)[0] = 1;
+
+                std::uint64_t entry {};
+                if (clear_soft_dirty(clear_refs))
+                {
+                    static_cast<volatile std::uint8_t*>(page)[0] = 2;
+
+                    const auto offset = static_cast<off_t>(reinterpret_cast<std::uintptr_t>(page) / page_size() * sizeof(entry));
+                    result            = pread(pagemap, &entry, sizeof(entry), offset) == sizeof(entry) && (entry & soft_dirty_bit);
+                }
+            }
+
+            if (page != MAP_FAILED)
+                munmap(page, page_size());
+            if (pagemap >= 0)
+                ::close(pagemap);
+            if (clear_refs >= 0)
+                ::close(clear_refs);
+
+            return result;
+        }();
+
+        return supported;
+    }
+}
+
+gensokyo::impl::SoftDirty::SoftDirty(std::uint32_t pid)
+{
+    if (pid == 0 || !kernel_supports_soft_dirty())
+        return;
+
+    // writing clear_refs needs the same user, reading pagemap needs ptrace access
+    _clear_refs = open(fmt::format("/proc/{}/clear_refs", pid).c_str(), O_WRONLY | O_CLOEXEC);
+    _pagemap    = open(fmt::format("/proc/{}/pagemap", pid).c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (!is_open())
+        close();
+}
+
+void gensokyo::impl::SoftDirty::close() noexcept
+{
+    if (_clear_refs >= 0)
+        ::close(static_cast<int>(_clear_refs));
+    if (_pagemap >= 0)
+        ::close(static_cast<int>(_pagemap));
+
+    _clear_refs = -1;
+    _pagemap    = -1;
+}
+
+bool gensokyo::impl::SoftDirty::clear()
+{
+    return is_open() && clear_soft_dirty(static_cast<int>(_clear_refs));
+}
+
+bool gensokyo::impl::SoftDirty::written(const MemoryRegion& region, std::vector<MemoryRegion>& ranges)
+{
+    if (!is_open() || region.size == 0)
+        return false;
+
+    // one 64-bit entry per page
+    const auto first = region.address / page_size();
+    const auto last  = (region.address + region.size - 1) / page_size();
+
+    std::vector<std::uint64_t> entries(last - first + 1);
+    const auto bytes = static_cast<ssize_t>(entries.size() * sizeof(std::uint64_t));
+    if (pread(static_cast<int>(_pagemap), entries.data(), static_cast<std::size_t>(bytes), static_cast<off_t>(first * sizeof(std::uint64_t))) != bytes)
+        return false;
+
+    for (std::size_t i = 0; i < entries.size(); i++)
+    {
+        if (!(entries[i] & soft_dirty_bit))
+            continue;
+
+        const auto address = (first + i) * page_size();
+        if (!ranges.empty() && ranges.back().address + ranges.back().size == address)
+            ranges.back().size += page_size();
+        else
+            ranges.push_back({ address, page_size() });
+    }
+
+    return true;
+}
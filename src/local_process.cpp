@@ -0,0 +1,106 @@
+#include <gensokyo.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <mutex>
+
+gensokyo::LocalProcess::LocalProcess()
+{
+    refresh();
+}
+
+bool gensokyo::LocalProcess::covers(const std::vector<impl::MemoryRegion>& ranges, std::uintptr_t address, std::size_t size) noexcept
+{
+    if (address + size < address)
+        return false;
+
+    // the last range that starts at or before address, merged ranges mean it has to hold all of it
+    const auto range = std::ranges::upper_bound(ranges, address, {}, &impl::MemoryRegion::address);
+    if (range == ranges.begin())
+        return false;
+
+    const auto& previous = *std::prev(range);
+    return address + size <= previous.address + previous.size;
+}
+
+bool gensokyo::LocalProcess::check(std::uintptr_t address, std::size_t size, bool write)
+{
+    {
+        std::shared_lock lock(_mutex);
+        if (covers(write ? _writable : _readable, address, size))
+            return true;
+    }
+
+    // nothing gets mapped there, don't read the map again for every bad pointer
+    if (!Address(address).is_valid() || address + size < address)
+        return false;
+
+    refresh();
+
+    std::shared_lock lock(_mutex);
+    return covers(write ? _writable : _readable, address, size);
+}
+
+void gensokyo::LocalProcess::refresh()
+{
+    std::vector<impl::MemoryRegion> readable {};
+    std::vector<impl::MemoryRegion> writable {};
+
+    const auto append = [](std::vector<impl::MemoryRegion>& ranges, const impl::Region& region)
+    {
+        if (!ranges.empty() && ranges.back().address + ranges.back().size == region.address)
+            ranges.back().size += region.size;
+        else
+            ranges.push_back({ region.address, region.size });
+    };
+
+    enumerate_regions(
+      [&](const impl::Region& region)
+      {
+          if (region.readable)
+              append(readable, region);
+          if (region.writable)
+              append(writable, region);
+
+          return false;
+      });
+
+    std::unique_lock lock(_mutex);
+    _readable = std::move(readable);
+    _writable = std::move(writable);
+}
+
+std::span<const std::uint8_t> gensokyo::LocalProcess::view(std::uintptr_t address, std::size_t size)
+{
+    if (!check(address, size, false))
+        return {};
+
+    return { reinterpret_cast<const std::uint8_t*>(address), size };
+}
+
+bool gensokyo::LocalProcess::read_impl(std::uintptr_t address, void* buffer, std::size_t size)
+{
+    if (!check(address, size, false))
+        return false;
+
+    // the buffer may be in the range that's read
+    std::memmove(buffer, reinterpret_cast<const void*>(address), size);
+    return true;
+}
+
+void gensokyo::LocalProcess::read_many_impl(std::span<impl::ReadRequest> requests)
+{
+    // there's no call to save, merging requests would only copy more
+    for (auto& request : requests)
+        request.success = read_impl(request.address, request.buffer, request.size);
+}
+
+bool gensokyo::LocalProcess::write_impl(std::uintptr_t address, void* buffer, std::size_t size)
+{
+    if (!check(address, size, true))
+        return false;
+
+    std::memmove(reinterpret_cast<void*>(address), buffer, size);
+    return true;
+}
@@ -0,0 +1,187 @@
+#include <gensokyo.hpp>
+
+#include <bit>
+#include <cstring>
+
+namespace
+{
+    // grow the last change when this one starts right where it ends
+    void append(std::vector<gensokyo::impl::MemoryRegion>& changes, std::uintptr_t address, std::size_t size)
+    {
+        if (!changes.empty() && changes.back().address + changes.back().size == address)
+            changes.back().size += size;
+        else
+            changes.push_back({ address, size });
+    }
+
+    template <typename SIMD>
+    void diff_simd(const std::uint8_t* previous, const std::uint8_t* current, std::size_t size, std::uintptr_t address, std::vector<gensokyo::impl::MemoryRegion>& changes)
+    {
+        using mask_type                   = typename SIMD::mask_type;
+        constexpr std::size_t simd_length = SIMD::simd_length;
+        constexpr std::size_t mask_bits   = sizeof(mask_type) * 8;
+        constexpr auto all_bytes          = simd_length == mask_bits ? ~mask_type {} : static_cast<mask_type>((mask_type(1) << simd_length) - 1);
+
+        std::size_t offset = 0;
+        for (; offset + simd_length <= size; offset += simd_length)
+        {
+            auto mask = SIMD::cmpeq_mask(SIMD::load_unaligned(previous + offset), SIMD::load_unaligned(current + offset)) ^ all_bytes;
+
+            // every run of set bits is a run of changed bytes
+            while (mask)
+            {
+                const auto start = static_cast<std::size_t>(std::countr_zero(mask));
+                const auto run   = static_cast<std::size_t>(std::countr_one(static_cast<mask_type>(mask >> start)));
+                append(changes, address + offset + start, run);
+
+                if (start + run == mask_bits)
+                    break;
+
+                mask &= ~mask_type {} << (start + run);
+            }
+        }
+
+        for (; offset < size; offset++)
+        {
+            if (previous[offset] != current[offset])
+                append(changes, address + offset, 1);
+        }
+    }
+
+    void diff(const std::uint8_t* previous, const std::uint8_t* current, std::size_t size, std::uintptr_t address, std::vector<gensokyo::impl::MemoryRegion>& changes)
+    {
+        const auto arch = gensokyo::cpu.get_arch();
+#if defined(GENSOKYO_SIMD_AVX512)
+        if (arch == gensokyo::CPUArch::AVX512)
+            return diff_simd<gensokyo::simd::iAVX512>(previous, current, size, address, changes);
+#endif
+        if (arch == gensokyo::CPUArch::AVX512 || arch == gensokyo::CPUArch::AVX2)
+            return diff_simd<gensokyo::simd::iAVX2>(previous, current, size, address, changes);
+
+        if (arch == gensokyo::CPUArch::SSE)
+            return diff_simd<gensokyo::simd::iSSE>(previous, current, size, address, changes);
+
+        for (std::size_t offset = 0; offset < size; offset++)
+        {
+            if (previous[offset] != current[offset])
+                append(changes, address + offset, 1);
+        }
+    }
+}
+
+gensokyo::MemoryWatch::MemoryWatch(impl::Process& process, bool soft_dirty)
+ : _process(process)
+{
+    if (soft_dirty)
+        _soft_dirty.emplace(process.get_pid());
+}
+
+std::optional<std::size_t> gensokyo::MemoryWatch::add(const impl::MemoryRegion& region)
+{
+    Watched watched { region, std::vector<std::uint8_t>(region.size) };
+    if (region.size == 0 || !_process.read(region.address, watched.snapshot.data(), region.size))
+        return std::nullopt;
+
+    _watched.push_back(std::move(watched));
+    return _watched.size() - 1;
+}
+
+void gensokyo::MemoryWatch::clear()
+{
+    _watched.clear();
+    _buffer = {};
+    _polls  = 0;
+}
+
+std::vector<gensokyo::impl::MemoryRegion> gensokyo::MemoryWatch::poll()
+{
+    // part of a watched region that is read again, at offset in the buffer
+    struct Pending
+    {
+        std::size_t watched {};
+        impl::MemoryRegion range {};
+        std::size_t offset {};
+    };
+
+    // pages of every region that was tracked, as a range of written
+    struct Tracked
+    {
+        std::size_t first {};
+        std::size_t last {};
+    };
+
+    std::vector<impl::MemoryRegion> written {};
+    std::vector<std::optional<Tracked>> tracked(_watched.size());
+
+    if (uses_soft_dirty())
+    {
+        // every few polls everything is compared, that catches the writes that landed between reading the bits and clearing them
+        if (++_polls % full_poll_interval != 0)
+        {
+            // the bits of all regions are read together right before they're cleared, so that window is as short as it gets
+            for (std::size_t i = 0; i < _watched.size(); i++)
+            {
+                const auto first = written.size();
+                if (_soft_dirty->written(_watched[i].region, written))
+                    tracked[i] = Tracked { first, written.size() };
+                else
+                    written.resize(first);
+            }
+        }
+
+        // writes from here on are noted for the next poll, everything read below is at least as new as this
+        _soft_dirty->clear();
+    }
+
+    std::vector<Pending> pending {};
+    std::size_t total {};
+
+    for (std::size_t i = 0; i < _watched.size(); i++)
+    {
+        const auto& region = _watched[i].region;
+
+        if (tracked[i])
+        {
+            // the pages are whole, the region may start or end inside one
+            for (auto j = tracked[i]->first; j < tracked[i]->last; j++)
+            {
+                const auto& page = written[j];
+                const auto begin = std::max(page.address, region.address);
+                const auto end   = std::min(page.address + page.size, region.address + region.size);
+                pending.push_back({ i, { begin, end - begin }, total });
+                total += end - begin;
+            }
+
+            continue;
+        }
+
+        pending.push_back({ i, region, total });
+        total += region.size;
+    }
+
+    _buffer.resize(total);
+
+    std::vector<impl::ReadRequest> requests {};
+    requests.reserve(pending.size());
+    for (const auto& entry : pending)
+        requests.push_back({ entry.range.address, _buffer.data() + entry.offset, entry.range.size });
+
+    _process.read_many(requests);
+
+    std::vector<impl::MemoryRegion> changes {};
+    for (std::size_t i = 0; i < pending.size(); i++)
+    {
+        if (!requests[i].success)
+            continue;
+
+        const auto& entry   = pending[i];
+        auto& watched       = _watched[entry.watched];
+        auto* previous      = watched.snapshot.data() + (entry.range.address - watched.region.address);
+        const auto* current = _buffer.data() + entry.offset;
+
+        diff(previous, current, entry.range.size, entry.range.address, changes);
+        std::memcpy(previous, current, entry.range.size);
+    }
+
+    return changes;
+}
@@ -0,0 +1,219 @@
+#include <gensokyo.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <stdexcept>
+
+namespace
+{
+    // same as a single buffer scan, small enough to stay in L2 while it's scanned
+    constexpr std::size_t chunk_size = 256 * 1024;
+
+    struct Chunk
+    {
+        std::size_t segment {};
+        std::size_t start {};
+        std::size_t length {};
+    };
+
+    // chunks overlap the next one by pattern_size - 1 bytes, so every match starts in exactly one chunk
+    std::vector<Chunk> split(const std::vector<gensokyo::impl::Segments>& segments, std::size_t pattern_size)
+    {
+        std::vector<Chunk> chunks {};
+        for (std::size_t i = 0; i < segments.size(); i++)
+        {
+            const auto size = segments[i].data.size();
+            for (std::size_t start = 0; start < size; start += chunk_size)
+                chunks.push_back({ i, start, std::min(chunk_size + pattern_size - 1, size - start) });
+        }
+
+        return chunks;
+    }
+
+    // like the local lookup, the file name with or without a version suffix
+    bool name_matches(std::string_view file_name, std::string_view name)
+    {
+        if (file_name.size() < name.size() || (file_name.size() > name.size() && file_name[name.size()] != '.'))
+            return false;
+
+#ifdef WINDOWS
+        // GetModuleHandleA doesn't care about case either
+        return std::ranges::equal(file_name.substr(0, name.size()), name,
+                                  [](char left, char right)
+                                  {
+                                      return std::tolower(static_cast<unsigned char>(left)) == std::tolower(static_cast<unsigned char>(right));
+                                  });
+#else
+        return file_name.starts_with(name);
+#endif
+    }
+
+    gensokyo::impl::ModuleInfo find_module(gensokyo::impl::Process& process, std::string_view name)
+    {
+        auto modules = process.modules();
+        const auto module = std::ranges::find_if(modules,
+                                                 [&](const gensokyo::impl::ModuleInfo& info)
+                                                 {
+                                                     return name.empty() ? info.program : name_matches(info.name, name);
+                                                 });
+
+        if (module == modules.end())
+            throw std::runtime_error("Failed to get module handle");
+
+        return std::move(*module);
+    }
+
+    // the scans return pointers into data, results are reported relative to where the segment lives
+    gensokyo::Address rebase(const gensokyo::impl::Segments& segment, gensokyo::Address result)
+    {
+        return segment.address + (result.ptr - reinterpret_cast<std::uintptr_t>(segment.data.data()));
+    }
+}
+
+gensokyo::impl::Module::Module(Process& process, std::string_view str, const FunctionCallbackFn& func)
+ : Module(process, find_module(process, str), func)
+{
+}
+
+gensokyo::impl::Module::Module(Process& process, const ModuleInfo& info, const FunctionCallbackFn& func)
+ : _baseAddress(info.base),
+   _size(info.size),
+   _identity(info.identity)
+{
+    std::size_t total {};
+    for (const auto& range : info.code)
+        total += range.size;
+
+    auto storage = std::make_shared<std::vector<std::uint8_t>>(total);
+
+    std::vector<ReadRequest> requests {};
+    for (std::size_t offset = 0; const auto& range : info.code)
+    {
+        requests.push_back({ range.address, storage->data() + offset, range.size });
+        offset += range.size;
+    }
+
+    if (process.read_many(requests) != requests.size())
+        throw std::runtime_error("Failed to read module segments");
+
+    for (const auto& request : requests)
+        _segments.emplace_back(request.address, static_cast<std::uint8_t*>(request.buffer), request.size);
+
+    _storage = std::move(storage);
+
+    logger.success("{} | base_addr:{:#05x} | size:{:#05x} | _segments.size():{}", info.name, _baseAddress, _size, _segments.size());
+
+    if (func)
+    {
+        // gaps between the mappings stay zero, only copy what can be read
+        std::vector<std::uint8_t> data(_size);
+        requests.clear();
+        process.for_each_region({ .readable = true },
+                                [&](const Region& region)
+                                {
+                                    const auto begin = std::max(region.address, _baseAddress);
+                                    const auto end   = std::min(region.address + region.size, _baseAddress + _size);
+                                    if (begin < end)
+                                        requests.push_back({ begin, data.data() + (begin - _baseAddress), end - begin });
+
+                                    return region.address >= _baseAddress + _size;
+                                });
+
+        process.read_many(requests);
+        func(data);
+    }
+}
+
+gensokyo::Address gensokyo::impl::Module::find(pattern::impl::PatternView pattern) const noexcept
+{
+    for (const auto& segment : _segments)
+    {
+        if (const auto result = pattern::find(segment.data, pattern); result.ptr)
+            return rebase(segment, result);
+    }
+
+    return {};
+}
+
+gensokyo::Address gensokyo::impl::Module::find(pattern::parallel_t, pattern::impl::PatternView pattern) const
+{
+    if (pattern.empty())
+        return find(pattern);
+
+    const auto chunks = split(_segments, pattern.size());
+    if (chunks.size() <= 1)
+        return find(pattern);
+
+    std::vector<gensokyo::Address> results(chunks.size());
+
+    // index of the first chunk with a match so far
+    std::atomic<std::size_t> best = chunks.size();
+
+    thread_pool.parallel_for(chunks.size(),
+                             [&](std::size_t index)
+                             {
+                                 // a later chunk can't have the first match
+                                 if (index > best.load(std::memory_order_relaxed))
+                                     return;
+
+                                 const auto& chunk   = chunks[index];
+                                 const auto& segment = _segments[chunk.segment];
+
+                                 const auto result = pattern::find(segment.data.subspan(chunk.start, chunk.length), pattern);
+                                 if (!result.ptr)
+                                     return;
+
+                                 results[index] = rebase(segment, result);
+
+                                 auto current = best.load();
+                                 while (index < current && !best.compare_exchange_weak(current, index))
+                                 {
+                                 }
+                             });
+
+    if (const auto index = best.load(); index < chunks.size())
+        return results[index];
+
+    return {};
+}
+
+std::vector<gensokyo::Address> gensokyo::impl::Module::find_all(pattern::impl::PatternView pattern) const
+{
+    std::vector<gensokyo::Address> results {};
+    for (const auto& segment : _segments)
+    {
+        for (const auto result : pattern::find_all(segment.data, pattern))
+            results.push_back(rebase(segment, result));
+    }
+
+    return results;
+}
+
+std::vector<gensokyo::Address> gensokyo::impl::Module::find_all(pattern::parallel_t, pattern::impl::PatternView pattern) const
+{
+    if (pattern.empty())
+        return find_all(pattern);
+
+    const auto chunks = split(_segments, pattern.size());
+    if (chunks.size() <= 1)
+        return find_all(pattern);
+
+    std::vector<std::vector<gensokyo::Address>> results(chunks.size());
+
+    thread_pool.parallel_for(chunks.size(),
+                             [&](std::size_t index)
+                             {
+                                 const auto& chunk   = chunks[index];
+                                 const auto& segment = _segments[chunk.segment];
+
+                                 for (const auto result : pattern::find_all(segment.data.subspan(chunk.start, chunk.length), pattern))
+                                     results[index].push_back(rebase(segment, result));
+                             });
+
+    std::vector<gensokyo::Address> matches {};
+    for (auto& result : results)
+        matches.insert(matches.end(), result.begin(), result.end());
+
+    return matches;
+}
@@ -1,8 +1,24 @@
 #include <gensokyo.hpp>
+#include <bit>
+#include <cstring>
 
-gensokyo::Address gensokyo::pattern::impl::find_brute_force(std::uint8_t* data, std::size_t size, const std::span<HexData>& pattern) noexcept
+bool gensokyo::pattern::impl::matches(const std::uint8_t* data, PatternView pattern) noexcept
+{
+    for (std::size_t i = 0; i < pattern.size(); ++i)
+    {
+        if (!pattern[i].matches(data[i]))
+            return false;
+    }
+
+    return true;
+}
+
+gensokyo::Address gensokyo::pattern::impl::find_brute_force(std::uint8_t* data, std::size_t size, PatternView pattern) noexcept
 {
     const auto pattern_size = pattern.size();
+    if (pattern_size > size)
+        return {};
+
     const std::uint8_t* end = data + size - pattern_size;
 
     for (const std::uint8_t* current = data; current <= end; ++current)
@@ -11,7 +27,7 @@ gensokyo::Address gensokyo::pattern::impl::find_brute_force(std::uint8_t* data,
 
         for (std::size_t j = 0; j < pattern_size; ++j)
         {
-            if (const auto& pattern_byte = pattern[j]; pattern_byte && *pattern_byte != current[j])
+            if (!pattern[j].matches(current[j]))
             {
                 found = false;
                 break;
@@ -27,146 +43,624 @@ gensokyo::Address gensokyo::pattern::impl::find_brute_force(std::uint8_t* data,
 }
 
 // https://github.com/BasedInc/libhat
-gensokyo::Address gensokyo::pattern::impl::find_std(std::uint8_t* data, std::size_t size, const std::span<HexData>& pattern) noexcept
+gensokyo::Address gensokyo::pattern::impl::find_std(std::uint8_t* data, std::size_t size, PatternView pattern) noexcept
 {
     const auto pattern_size = pattern.size();
-    std::uint8_t* end       = data + size - pattern_size;
-    const auto first_byte   = pattern[0].value();
+    if (pattern_size > size)
+        return {};
 
-    for (std::uint8_t* current = data; current <= end; ++current)
+    // a pattern of only wildcards matches right away
+    const auto anchor = find_anchor(pattern);
+    if (anchor == pattern_size)
+        return data;
+
+    // end is the anchor of the last position where the pattern still fits
+    std::uint8_t* end      = data + size - pattern_size + 1 + anchor;
+    const auto anchor_byte = pattern[anchor];
+
+    for (std::uint8_t* current = data + anchor; current < end; ++current)
     {
-        current = std::find(current, end, first_byte);
+        if (anchor_byte.is_exact())
+        {
+            current = std::find(current, end, anchor_byte.value());
+        }
+        else
+        {
+            current = std::find_if(current,
+                                   end,
+                                   [&](std::uint8_t byte)
+                                   {
+                                       return anchor_byte.matches(byte);
+                                   });
+        }
 
         if (current == end)
         {
             break;
         }
 
-        auto matched = std::equal(pattern.begin() + 1,
-                                  pattern.end(),
-                                  current + 1,
-                                  [](auto opt, auto byte)
-                                  {
-                                      return !opt.has_value() || *opt == byte;
-                                  });
+        auto matched = matches(current - anchor, pattern);
 
         if (matched)
         {
-            return &*current;
+            return current - anchor;
         }
     }
     return {};
 }
 
-template <typename SIMD>
-gensokyo::Address gensokyo::pattern::impl::find_simd(std::uint8_t* data, std::size_t size, const std::span<HexData>& pattern) noexcept
+gensokyo::pattern::impl::ScanState::ScanState(std::uint8_t* data_, std::size_t size_, PatternView pattern_) noexcept
+ : data(data_),
+   size(size_),
+   pattern(pattern_)
+{
+    anchor        = find_anchor(pattern);
+    second_anchor = find_anchor(pattern, anchor);
+
+    for (std::size_t i = 0; i < pattern.size() && i < bytes.size(); i++)
+    {
+        bytes[i] = pattern[i].byte;
+        masks[i] = pattern[i].mask;
+    }
+}
+
+gensokyo::Address gensokyo::pattern::impl::find_std_next(ScanState& state) noexcept
+{
+    if (state.offset >= state.size)
+        return {};
+
+    const auto result = find_std(state.data + state.offset, state.size - state.offset, state.pattern);
+    state.offset      = result.ptr ? result.ptr - reinterpret_cast<std::uintptr_t>(state.data) + 1 : state.size;
+    return result;
+}
+
+template <typename SIMD, bool DualAnchor>
+gensokyo::Address gensokyo::pattern::impl::find_simd_next(ScanState& state) noexcept
 {
     constexpr int simd_length = SIMD::simd_length;
-    const auto pattern_size   = pattern.size();
+    const auto pattern_size   = state.pattern.size();
 
-    // when pattern size is larger than the current cpu instruction supports, fallback to std implementation
-    if (pattern_size > simd_length)
-        return find_std(data, size, pattern);
+    // when pattern size is larger than the scan state holds or there is nothing to anchor on, fallback to std implementation
+    if (pattern_size > ScanState::max_simd_pattern || state.anchor == pattern_size)
+        return find_std_next(state);
 
-    auto make_pattern_simd = [&]
+    // a single concrete byte has no second anchor
+    if constexpr (DualAnchor)
     {
-        std::array<std::byte, simd_length> bytes {};
-        std::array<std::byte, simd_length> masks {};
-        for (std::size_t i = 1; i < pattern_size; i++)
+        if (state.second_anchor == pattern_size)
+            return find_simd_next<SIMD>(state);
+    }
+
+    // the pattern is verified one register at a time
+    const auto num_registers = (pattern_size + simd_length - 1) / simd_length;
+
+    // pattern data, the first register is kept loaded since every candidate checks it
+    const auto anchor_byte   = SIMD::set1_epi8(state.pattern[state.anchor].byte);
+    const auto anchor_mask   = SIMD::set1_epi8(state.pattern[state.anchor].mask);
+    const auto second_byte   = DualAnchor ? SIMD::set1_epi8(state.pattern[state.second_anchor].byte) : anchor_byte;
+    const auto second_mask   = DualAnchor ? SIMD::set1_epi8(state.pattern[state.second_anchor].mask) : anchor_mask;
+    const auto pattern_bytes = SIMD::load_unaligned(state.bytes.data());
+    const auto pattern_masks = SIMD::load_unaligned(state.masks.data());
+
+    // a block loads simd_length bytes at the anchor and a candidate loads num_registers * simd_length bytes
+    const auto load_size      = (num_registers + 1) * simd_length;
+    const auto num_iterations = state.size >= load_size ? (state.size - load_size) / simd_length + 1 : 0;
+    const auto simd_end       = num_iterations * simd_length;
+
+    while (true)
+    {
+        while (state.mask)
         {
-            if (pattern[i].has_value())
+            // Find the index of the least significant set bit (first match)
+            const auto offset = std::countr_zero(state.mask);
+
+            // Clear the least significant set bit, so the scan resumes after it on the next call
+            state.mask &= state.mask - 1;
+
+            // Calculate the pointer to the start of the candidate, the mask belongs to the block before offset
+            const auto byte_ptr = state.data + state.offset - simd_length + offset;
+
+            // Load the data chunk at the candidate into a SIMD register
+            const auto data_chunk = SIMD::load_unaligned(SIMD::cast(byte_ptr));
+
+            // Test if all the required bytes in the pattern match the data chunk
+            auto matched = SIMD::equal_masked(data_chunk, pattern_bytes, pattern_masks);
+
+            // Longer patterns go on with the next registers until one of them differs
+            for (std::size_t i = 1; matched && i < num_registers; i++)
+            {
+                const auto index = i * simd_length;
+                matched          = SIMD::equal_masked(SIMD::load_unaligned(byte_ptr + index),
+                                             SIMD::load_unaligned(state.bytes.data() + index),
+                                             SIMD::load_unaligned(state.masks.data() + index));
+            }
+
+            // If the entire pattern is matched, return the address of the match
+            if (matched)
             {
-                bytes[i - 1] = std::byte { pattern[i].value() };
-                masks[i - 1] = std::byte { 0xff };
+                return { byte_ptr };
             }
         }
 
-        return std::make_pair(SIMD::load_unaligned(bytes.data()), SIMD::load_unaligned(masks.data()));
+        if (state.offset >= simd_end)
+            break;
+
+        // bit i is set when the candidate starting at offset + i has the anchor byte in place, the mask keeps only its known bits
+        const auto first = SIMD::and_si(SIMD::load_unaligned(state.data + state.offset + state.anchor), anchor_mask);
+        if constexpr (DualAnchor && simd_length == 64)
+        {
+            // compares already produce masks, and them instead of the vectors
+            const auto second = SIMD::and_si(SIMD::load_unaligned(state.data + state.offset + state.second_anchor), second_mask);
+            state.mask        = SIMD::cmpeq_mask(anchor_byte, first) & SIMD::cmpeq_mask(second_byte, second);
+        }
+        else if constexpr (DualAnchor)
+        {
+            const auto second = SIMD::and_si(SIMD::load_unaligned(state.data + state.offset + state.second_anchor), second_mask);
+            state.mask        = SIMD::movemask_epi8(SIMD::and_si(SIMD::cmpeq_epi8(anchor_byte, first), SIMD::cmpeq_epi8(second_byte, second)));
+        }
+        else
+        {
+            state.mask = SIMD::cmpeq_mask(anchor_byte, first);
+        }
+        state.offset += simd_length;
+    }
+
+    // Look in remaining bytes that couldn't be grouped into simd_length * 8 bits
+    return find_std_next(state);
+}
+
+template <typename SIMD, bool DualAnchor>
+gensokyo::Address gensokyo::pattern::impl::find_simd(std::uint8_t* data, std::size_t size, PatternView pattern) noexcept
+{
+    ScanState state(data, size, pattern);
+    return find_simd_next<SIMD, DualAnchor>(state);
+}
+
+bool gensokyo::pattern::impl::prefer_dual_anchor(const ScanState& state) noexcept
+{
+    if (state.second_anchor == state.pattern.size())
+        return false;
+
+    // a partly known byte matches several values, treat it as common
+    const auto& anchor = state.pattern[state.anchor];
+    return !anchor.is_exact() || byte_frequency[anchor.byte] >= 128;
+}
+
+// widest kernel the cpu supports, with a second anchor when the first one is too common to filter well on its own
+static gensokyo::pattern::impl::ScanNextFn select_kernel(const gensokyo::pattern::impl::ScanState& state) noexcept
+{
+    using namespace gensokyo::pattern;
+
+    const auto arch = gensokyo::cpu.get_arch();
+    if (arch == gensokyo::CPUArch::NONE || state.pattern.size() > impl::ScanState::max_simd_pattern)
+        return &impl::find_std_next;
+
+    const auto dual = impl::prefer_dual_anchor(state);
+#if defined(GENSOKYO_SIMD_AVX512)
+    if (arch == gensokyo::CPUArch::AVX512)
+        return dual ? &impl::find_simd_next<gensokyo::simd::iAVX512, true> : &impl::find_simd_next<gensokyo::simd::iAVX512>;
+#endif
+    if (arch == gensokyo::CPUArch::AVX512 || arch == gensokyo::CPUArch::AVX2)
+        return dual ? &impl::find_simd_next<gensokyo::simd::iAVX2, true> : &impl::find_simd_next<gensokyo::simd::iAVX2>;
+
+    return dual ? &impl::find_simd_next<gensokyo::simd::iSSE, true> : &impl::find_simd_next<gensokyo::simd::iSSE>;
+}
+
+gensokyo::Address gensokyo::pattern::find(const std::span<std::uint8_t>& data, impl::PatternView pattern) noexcept
+{
+    impl::ScanState state(data.data(), data.size(), pattern);
+    return select_kernel(state)(state);
+}
+
+gensokyo::Address gensokyo::pattern::find(const std::span<std::uint8_t>& data, const impl::Pattern<>& pattern) noexcept
+{
+    return find(data, pattern.bytes);
+}
+
+gensokyo::Address gensokyo::pattern::find(parallel_t, const std::span<std::uint8_t>& data, impl::PatternView pattern)
+{
+    // small enough to stay in L2 while it's scanned
+    constexpr std::size_t chunk_size = 256 * 1024;
+
+    const auto pattern_size = pattern.size();
+    if (data.size() <= chunk_size * 2 || pattern_size == 0)
+        return find(data, pattern);
+
+    // offset of the lowest match found so far
+    std::atomic<std::size_t> best = data.size();
+
+    thread_pool.parallel_for((data.size() + chunk_size - 1) / chunk_size,
+                             [&](std::size_t index)
+                             {
+                                 const auto start = index * chunk_size;
+
+                                 // a chunk that starts after the best match can't have a lower one
+                                 if (start >= best.load(std::memory_order_relaxed))
+                                     return;
+
+                                 // overlap the next chunk so a match crossing the boundary is still found
+                                 const auto length = std::min(chunk_size + pattern_size - 1, data.size() - start);
+                                 const auto result = find(data.subspan(start, length), pattern);
+                                 if (!result.ptr)
+                                     return;
+
+                                 const auto offset = result.ptr - reinterpret_cast<std::uintptr_t>(data.data());
+                                 auto current      = best.load();
+                                 while (offset < current && !best.compare_exchange_weak(current, offset))
+                                 {
+                                 }
+                             });
+
+    if (const auto offset = best.load(); offset < data.size())
+        return data.data() + offset;
+
+    return {};
+}
+
+gensokyo::Address gensokyo::pattern::find(parallel_t, const std::span<std::uint8_t>& data, const impl::Pattern<>& pattern)
+{
+    return find(parallel, data, pattern.bytes);
+}
+
+gensokyo::pattern::MatchRange gensokyo::pattern::find_all(const std::span<std::uint8_t>& data, impl::PatternView pattern) noexcept
+{
+    impl::ScanState state(data.data(), data.size(), pattern);
+    return MatchRange(state, select_kernel(state));
+}
+
+gensokyo::pattern::MatchRange gensokyo::pattern::find_all(const std::span<std::uint8_t>& data, const impl::Pattern<>& pattern) noexcept
+{
+    return find_all(data, pattern.bytes);
+}
+
+// longest run of concrete bytes up to max_length, the last one wins since signatures usually share their prologue bytes
+static std::pair<std::size_t, std::size_t> find_fingerprint(gensokyo::pattern::impl::PatternView pattern, std::size_t max_length) noexcept
+{
+    std::size_t best_offset = 0, best_length = 0, run = 0;
+    for (std::size_t i = 0; i < pattern.size(); i++)
+    {
+        run = pattern[i].is_exact() ? std::min(run + 1, max_length) : 0;
+        if (run && run >= best_length)
+        {
+            best_offset = i + 1 - run;
+            best_length = run;
+        }
+    }
+
+    return { best_offset, best_length };
+}
+
+std::vector<gensokyo::Address> gensokyo::pattern::impl::find_many_std(std::uint8_t* data, std::size_t size, std::span<const Pattern<>> patterns)
+{
+    constexpr std::size_t max_window = 4;
+
+    struct Entry
+    {
+        std::uint16_t hash;
+        std::uint32_t index;
+        std::size_t offset;
+    };
+
+    // patterns are grouped by their fingerprint length, every group has a bitmap of fingerprint hashes for a quick reject
+    struct Group
+    {
+        std::uint32_t key_mask {};
+        std::vector<std::uint8_t> bitmap {};
+        std::vector<Entry> entries {};
+    };
+
+    auto hash = [](std::uint32_t key)
+    {
+        return static_cast<std::uint16_t>((key * 0x9E3779B1u) >> 16);
     };
 
-    const uint8_t* current = data;
-    const uint8_t* end     = current + size;
+    std::vector<gensokyo::Address> results(patterns.size());
+    std::vector<bool> resolved(patterns.size());
+    std::array<Group, max_window + 1> groups {};
+    std::size_t remaining = 0;
 
-    // pattern data
-    const auto first_byte                     = SIMD::set1_epi8(static_cast<int8_t>(pattern[0].value()));
-    const auto [pattern_bytes, pattern_masks] = make_pattern_simd();
+    for (std::size_t i = 0; i < patterns.size(); i++)
+    {
+        if (patterns[i].size() == 0 || patterns[i].size() > size)
+            continue;
 
-    // load dataset into simd
-    auto simd_data_ptr        = SIMD::cast(data);
-    const auto num_iterations = static_cast<size_t>(end - pattern_size - data) / simd_length;
-    auto simd_end_ptr         = simd_data_ptr + num_iterations;
+        const auto [offset, length] = find_fingerprint(patterns[i].bytes, max_window);
+
+        std::uint32_t key = 0;
+        for (std::size_t j = 0; j < length; j++)
+            key |= static_cast<std::uint32_t>(patterns[i][offset + j].value()) << (j * 8);
+
+        groups[length].entries.push_back({ hash(key), static_cast<std::uint32_t>(i), offset });
+        remaining++;
+    }
 
-    for (; simd_data_ptr != simd_end_ptr; ++simd_data_ptr)
+    // nothing to hash without a concrete byte, these are looked up on their own
+    for (auto& entry : groups[0].entries)
     {
-        const auto cmp = SIMD::cmpeq_epi8(first_byte, SIMD::load_unaligned(simd_data_ptr));
-        auto mask      = static_cast<uint32_t>(SIMD::movemask_epi8(cmp));
-        while (mask)
+        results[entry.index]  = find_std(data, size, patterns[entry.index].bytes);
+        resolved[entry.index] = true;
+        remaining--;
+    }
+
+    std::array<Group*, max_window> active_groups {};
+    std::size_t active_count = 0;
+    for (std::size_t length = 1; length <= max_window; length++)
+    {
+        auto& group = groups[length];
+        if (group.entries.empty())
+            continue;
+
+        std::ranges::sort(group.entries, {}, &Entry::hash);
+        group.key_mask = length == 4 ? 0xFFFFFFFF : (1u << (length * 8)) - 1;
+        group.bitmap.resize(0x10000 / 8);
+        for (const auto& entry : group.entries)
+            group.bitmap[entry.hash >> 3] |= static_cast<std::uint8_t>(1 << (entry.hash & 7));
+
+        active_groups[active_count++] = &group;
+    }
+
+    // verify every unresolved pattern of the group whose fingerprint hash is the same as the one at current
+    auto verify = [&](Group& group, std::uint16_t key_hash, std::size_t current)
+    {
+        const auto [first, last] = std::ranges::equal_range(group.entries, key_hash, {}, &Entry::hash);
+
+        bool pending = false;
+        for (auto it = first; it != last; ++it)
         {
-            // Find the index of the least significant set bit (first match)
-            std::uint32_t offset;
-            if constexpr (simd_length == 32)
+            if (resolved[it->index])
+                continue;
+
+            auto& pattern = patterns[it->index].bytes;
+            if (current >= it->offset && pattern.size() <= size - (current - it->offset) && matches(data + current - it->offset, pattern))
             {
-                offset = _tzcnt_u32(mask);
+                results[it->index]  = data + current - it->offset;
+                resolved[it->index] = true;
+                remaining--;
+                continue;
             }
-            else
+
+            pending = true;
+        }
+
+        if (!pending)
+            group.bitmap[key_hash >> 3] &= static_cast<std::uint8_t>(~(1 << (key_hash & 7)));
+    };
+
+    auto scan = [&](std::size_t current, std::uint32_t word)
+    {
+        for (std::size_t i = 0; i < active_count; i++)
+        {
+            auto& group         = *active_groups[i];
+            const auto key_hash = hash(word & group.key_mask);
+
+            if (group.bitmap[key_hash >> 3] & (1 << (key_hash & 7))) [[unlikely]]
+                verify(group, key_hash, current);
+        }
+    };
+
+    std::size_t current = 0;
+    for (; current + sizeof(std::uint32_t) <= size && remaining; current++)
+    {
+        std::uint32_t word;
+        std::memcpy(&word, data + current, sizeof(word));
+        scan(current, word);
+    }
+
+    // the last few bytes can't fill a whole word, the missing bytes are zero and never part of a shorter fingerprint
+    for (; current < size && remaining; current++)
+    {
+        std::uint32_t word = 0;
+        std::memcpy(&word, data + current, size - current);
+        scan(current, word);
+    }
+
+    return results;
+}
+
+template <typename SIMD>
+std::vector<gensokyo::Address> gensokyo::pattern::impl::find_many_simd(std::uint8_t* data, std::size_t size, std::span<const Pattern<>> patterns)
+{
+    using simd_type                           = decltype(SIMD::setzero());
+    constexpr std::size_t simd_length         = SIMD::simd_length;
+    constexpr std::size_t bucket_count        = 8;
+    constexpr std::size_t max_fingerprint_len = 3;
+
+    std::vector<gensokyo::Address> results(patterns.size());
+
+    // every pattern is anchored on its own fingerprint, they all have the same length so a block can test every bucket at once
+    std::vector<std::size_t> order {};
+    std::vector<std::size_t> fingerprints(patterns.size());
+    std::size_t fingerprint_len = max_fingerprint_len;
+    for (std::size_t i = 0; i < patterns.size(); i++)
+    {
+        if (patterns[i].size() == 0 || patterns[i].size() > size)
+            continue;
+
+        order.push_back(i);
+        fingerprint_len = std::min(fingerprint_len, patterns[i].size());
+    }
+
+    if (order.empty())
+        return results;
+
+    for (const auto index : order)
+    {
+        const auto [offset, length] = find_fingerprint(patterns[index].bytes, fingerprint_len);
+        fingerprints[index]         = std::min(offset, patterns[index].size() - fingerprint_len);
+    }
+
+    auto fingerprint = [&](std::size_t index)
+    {
+        return std::span(patterns[index].bytes).subspan(fingerprints[index], fingerprint_len);
+    };
+
+    // keep similar fingerprints together, so a bucket doesn't mix too many nibbles
+    std::ranges::sort(order,
+                      [&](std::size_t a, std::size_t b)
+                      {
+                          return std::ranges::lexicographical_compare(fingerprint(a),
+                                                                      fingerprint(b),
+                                                                      [](const HexData& x, const HexData& y)
+                                                                      {
+                                                                          return std::pair(x.mask, x.byte) < std::pair(y.mask, y.byte);
+                                                                      });
+                      });
+
+    // every fingerprint byte has a low and a high nibble table, each entry is a bitset of buckets that accept that nibble
+    std::array<std::vector<std::size_t>, bucket_count> buckets {};
+    std::array<std::array<std::uint8_t, 16>, max_fingerprint_len> low_nibbles {};
+    std::array<std::array<std::uint8_t, 16>, max_fingerprint_len> high_nibbles {};
+
+    for (std::size_t i = 0; i < order.size(); i++)
+    {
+        const auto bucket = i * bucket_count / order.size();
+        const auto bit    = static_cast<std::uint8_t>(1 << bucket);
+        const auto bytes  = fingerprint(order[i]);
+
+        buckets[bucket].push_back(order[i]);
+
+        for (std::size_t j = 0; j < fingerprint_len; j++)
+        {
+            // every nibble that agrees with the known bits of the byte, all 16 for a wildcard
+            for (std::size_t nibble = 0; nibble < 16; nibble++)
             {
-#ifdef MSVC
-                unsigned long temp;
-                _BitScanForward(&temp, mask);
-                offset = temp;
-#elif defined(GCC) || defined(CLANG)
-                offset = __builtin_ctz(mask);
-#endif
+                if ((nibble & bytes[j].mask & 0xF) == (bytes[j].byte & 0xF))
+                    low_nibbles[j][nibble] |= bit;
+                if ((nibble & bytes[j].mask >> 4) == bytes[j].byte >> 4)
+                    high_nibbles[j][nibble] |= bit;
             }
+        }
+    }
 
-            // Calculate the pointer to the matched byte in the data
-            const auto byte_ptr = reinterpret_cast<const std::uint8_t*>(simd_data_ptr) + offset;
-
-            // Load the data chunk after the matched first byte into a SIMD register
-            const auto data_chunk = SIMD::load_unaligned(SIMD::cast(byte_ptr + 1));
+    std::uint8_t active_buckets = 0;
+    for (std::size_t i = 0; i < bucket_count; i++)
+    {
+        if (!buckets[i].empty())
+            active_buckets |= static_cast<std::uint8_t>(1 << i);
+    }
 
-            // Compare the data chunk to the pattern bytes (excluding the first byte)
-            const auto cmp_to_sig = SIMD::cmpeq_epi8(pattern_bytes, data_chunk);
+    std::size_t remaining = order.size();
 
-            // Test if all the required bytes in the pattern match the data chunk
-            const auto matched = SIMD::test(cmp_to_sig, pattern_masks);
+    // check every unresolved pattern in bucket against the fingerprint at current, resolved patterns are removed so they never get checked again
+    auto verify_bucket = [&](std::size_t bucket, std::size_t current)
+    {
+        auto& candidates = buckets[bucket];
+        for (std::size_t i = 0; i < candidates.size();)
+        {
+            const auto index = candidates[i];
+            const auto start = current - fingerprints[index];
 
-            // If the entire pattern is matched, return the address of the match
-            if (matched)
+            if (auto& pattern = patterns[index].bytes; current >= fingerprints[index] && pattern.size() <= size - start && matches(data + start, pattern))
             {
-                return { const_cast<std::uint8_t*>(byte_ptr) };
+                results[index] = data + start;
+                candidates[i]  = candidates.back();
+                candidates.pop_back();
+                remaining--;
+                continue;
             }
 
-            // Clear the least significant set bit and continue searching for matches
-            if constexpr (simd_length == 32)
-                mask = _blsr_u32(mask);
-            else
-                mask &= (mask - 1);
+            i++;
+        }
+
+        if (candidates.empty())
+            active_buckets &= static_cast<std::uint8_t>(~(1 << bucket));
+    };
+
+    simd_type low_tables[max_fingerprint_len] {};
+    simd_type high_tables[max_fingerprint_len] {};
+    for (std::size_t i = 0; i < fingerprint_len; i++)
+    {
+        low_tables[i]  = SIMD::broadcast_si128(low_nibbles[i].data());
+        high_tables[i] = SIMD::broadcast_si128(high_nibbles[i].data());
+    }
+
+    const auto nibble_mask = SIMD::set1_epi8(0x0F);
+    const auto zero        = SIMD::setzero();
+
+    // every block loads simd_length bytes at each fingerprint byte
+    const auto block_span = simd_length + fingerprint_len - 1;
+    const auto num_blocks = size >= block_span ? (size - block_span) / simd_length + 1 : 0;
+
+    std::size_t current = 0;
+    std::array<std::uint8_t, simd_length> block_buckets {};
+
+    for (std::size_t block = 0; block < num_blocks && remaining; block++, current += simd_length)
+    {
+        auto candidates = SIMD::set1_epi8(active_buckets);
+        for (std::size_t i = 0; i < fingerprint_len; i++)
+        {
+            const auto chunk = SIMD::load_unaligned(data + current + i);
+            const auto low   = SIMD::and_si(chunk, nibble_mask);
+            const auto high  = SIMD::and_si(SIMD::template srli_epi16<4>(chunk), nibble_mask);
+            candidates       = SIMD::and_si(candidates, SIMD::and_si(SIMD::shuffle_epi8(low_tables[i], low), SIMD::shuffle_epi8(high_tables[i], high)));
+        }
+
+        // a set bit means at least one bucket may match at that offset
+        auto mask = static_cast<typename SIMD::mask_type>(~SIMD::cmpeq_mask(candidates, zero));
+        if constexpr (simd_length == 16)
+            mask &= 0xFFFF;
+
+        if (!mask)
+            continue;
+
+        SIMD::store_unaligned(block_buckets.data(), candidates);
+
+        for (; mask; mask &= mask - 1)
+        {
+            const auto offset = std::countr_zero(mask);
+            for (auto bits = block_buckets[offset]; bits; bits &= bits - 1)
+                verify_bucket(std::countr_zero(bits), current + offset);
         }
     }
 
-    // Look in remaining bytes that couldn't be grouped into simd_length * 8 bits
-    data = reinterpret_cast<std::uint8_t*>(simd_data_ptr);
-    return find_std(data, end - data, pattern);
+    // Look in remaining bytes that couldn't be grouped into a block
+    for (; current < size && remaining; ++current)
+    {
+        for (std::size_t i = 0; i < bucket_count; i++)
+        {
+            if (active_buckets & (1 << i))
+                verify_bucket(i, current);
+        }
+    }
+
+    return results;
 }
 
-gensokyo::Address gensokyo::pattern::find(const std::span<std::uint8_t>& data, const std::span<impl::HexData>& pattern) noexcept
+std::vector<gensokyo::Address> gensokyo::pattern::find_many(const std::span<std::uint8_t>& data, std::span<const impl::Pattern<>> patterns)
 {
     const auto arch = cpu.get_arch();
 
-    if (arch == CPUArch::AVX2 || arch == CPUArch::SSE)
+    // buckets saturate when there are too many fingerprints, the hashed filter scales better after that
+    if (patterns.size() <= 64)
     {
-        const auto pattern_size = pattern.size();
-        if (pattern_size <= 33 && arch == CPUArch::AVX2)
-            return impl::find_simd<simd::iAVX2>(data.data(), data.size(), pattern);
-        if (pattern_size <= 17)
-            return impl::find_simd<simd::iSSE>(data.data(), data.size(), pattern);
+#if defined(GENSOKYO_SIMD_AVX512)
+        if (arch == CPUArch::AVX512)
+            return impl::find_many_simd<simd::iAVX512>(data.data(), data.size(), patterns);
+#endif
+        if (arch == CPUArch::AVX512 || arch == CPUArch::AVX2)
+            return impl::find_many_simd<simd::iAVX2>(data.data(), data.size(), patterns);
+        if (arch == CPUArch::SSE)
+            return impl::find_many_simd<simd::iSSE>(data.data(), data.size(), patterns);
     }
 
-    return impl::find_std(data.data(), data.size(), pattern);
+    return impl::find_many_std(data.data(), data.size(), patterns);
 }
 
-gensokyo::Address gensokyo::pattern::find(const std::span<std::uint8_t>& data, impl::Pattern<> pattern) noexcept
-{
-    return find(data, pattern.bytes);
-}
+// kernels are part of the public interface (e.g. for tests and benchmarks), so they shouldn't depend on being inlined into find
+template gensokyo::Address gensokyo::pattern::impl::find_simd<gensokyo::simd::iSSE, false>(std::uint8_t*, std::size_t, PatternView) noexcept;
+template gensokyo::Address gensokyo::pattern::impl::find_simd_next<gensokyo::simd::iSSE, false>(ScanState&) noexcept;
+template gensokyo::Address gensokyo::pattern::impl::find_simd<gensokyo::simd::iSSE, true>(std::uint8_t*, std::size_t, PatternView) noexcept;
+template gensokyo::Address gensokyo::pattern::impl::find_simd_next<gensokyo::simd::iSSE, true>(ScanState&) noexcept;
+template std::vector<gensokyo::Address> gensokyo::pattern::impl::find_many_simd<gensokyo::simd::iSSE>(std::uint8_t*, std::size_t, std::span<const Pattern<>>);
+template gensokyo::Address gensokyo::pattern::impl::find_simd<gensokyo::simd::iAVX2, false>(std::uint8_t*, std::size_t, PatternView) noexcept;
+template gensokyo::Address gensokyo::pattern::impl::find_simd_next<gensokyo::simd::iAVX2, false>(ScanState&) noexcept;
+template gensokyo::Address gensokyo::pattern::impl::find_simd<gensokyo::simd::iAVX2, true>(std::uint8_t*, std::size_t, PatternView) noexcept;
+template gensokyo::Address gensokyo::pattern::impl::find_simd_next<gensokyo::simd::iAVX2, true>(ScanState&) noexcept;
+template std::vector<gensokyo::Address> gensokyo::pattern::impl::find_many_simd<gensokyo::simd::iAVX2>(std::uint8_t*, std::size_t, std::span<const Pattern<>>);
+#if defined(GENSOKYO_SIMD_AVX512)
+template gensokyo::Address gensokyo::pattern::impl::find_simd<gensokyo::simd::iAVX512, false>(std::uint8_t*, std::size_t, PatternView) noexcept;
+template gensokyo::Address gensokyo::pattern::impl::find_simd_next<gensokyo::simd::iAVX512, false>(ScanState&) noexcept;
+template gensokyo::Address gensokyo::pattern::impl::find_simd<gensokyo::simd::iAVX512, true>(std::uint8_t*, std::size_t, PatternView) noexcept;
+template gensokyo::Address gensokyo::pattern::impl::find_simd_next<gensokyo::simd::iAVX512, true>(ScanState&) noexcept;
+template std::vector<gensokyo::Address> gensokyo::pattern::impl::find_many_simd<gensokyo::simd::iAVX512>(std::uint8_t*, std::size_t, std::span<const Pattern<>>);
+#endif
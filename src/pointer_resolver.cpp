@@ -0,0 +1,76 @@
+#include <gensokyo.hpp>
+
+gensokyo::PointerResolver::PointerResolver(impl::Process& process)
+ : _process(process)
+{
+}
+
+std::size_t gensokyo::PointerResolver::add(Chain chain)
+{
+    _chains.push_back(std::move(chain));
+    _results.emplace_back();
+    return _chains.size() - 1;
+}
+
+void gensokyo::PointerResolver::clear()
+{
+    _chains.clear();
+    _results.clear();
+}
+
+std::size_t gensokyo::PointerResolver::resolve()
+{
+    _results = resolve(_process, _chains);
+
+    return static_cast<std::size_t>(std::ranges::count_if(_results,
+                                                          [](const gensokyo::Address& result)
+                                                          {
+                                                              return result.ptr != 0;
+                                                          }));
+}
+
+std::vector<gensokyo::Address> gensokyo::PointerResolver::resolve(impl::Process& process, std::span<const Chain> chains)
+{
+    std::vector<gensokyo::Address> results(chains.size());
+    std::vector<std::uintptr_t> values(chains.size());
+    std::vector<std::size_t> active {};
+    std::vector<impl::ReadRequest> requests {};
+
+    for (std::size_t index = 0; index < chains.size(); index++)
+    {
+        results[index] = chains[index].base;
+        if (!chains[index].offsets.empty())
+            active.push_back(index);
+    }
+
+    // every chain that's still going is one level further after each read_many
+    for (std::size_t level = 0; !active.empty(); level++)
+    {
+        requests.clear();
+        for (const auto index : active)
+            requests.push_back({ results[index].ptr, &values[index], sizeof(std::uintptr_t) });
+
+        process.read_many(requests);
+
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < active.size(); i++)
+        {
+            const auto index    = active[i];
+            const auto& offsets = chains[index].offsets;
+
+            if (!requests[i].success || !gensokyo::Address(values[index]).is_valid())
+            {
+                results[index] = {};
+                continue;
+            }
+
+            results[index] = values[index] + offsets[level];
+            if (level + 1 < offsets.size())
+                active[kept++] = index;
+        }
+
+        active.resize(kept);
+    }
+
+    return results;
+}
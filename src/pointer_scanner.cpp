@@ -0,0 +1,427 @@
+#include <gensokyo.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace
+{
+    // a big heap is split into pieces of this size so every thread gets some of it
+    constexpr std::size_t snapshot_piece = 4 * 1024 * 1024;
+
+    // addresses of a level handed to one thread at a time
+    constexpr std::size_t level_batch = 256;
+}
+
+std::string gensokyo::PointerPath::to_string() const
+{
+    auto text = fmt::format("{}+{:#x}", module, offset);
+    for (const auto value : offsets)
+        text += fmt::format(",{:#x}", value);
+
+    return text;
+}
+
+std::optional<gensokyo::PointerPath> gensokyo::PointerPath::parse(std::string_view text)
+{
+    // a module name may contain a '+', the offsets can't
+    const auto plus = text.rfind('+');
+    if (plus == std::string_view::npos || plus == 0)
+        return std::nullopt;
+
+    PointerPath path {};
+    path.module = text.substr(0, plus);
+
+    auto rest = text.substr(plus + 1);
+    for (auto first = true;; first = false)
+    {
+        const auto comma = rest.find(',');
+        auto field       = rest.substr(0, comma);
+        if (!field.starts_with("0x"))
+            return std::nullopt;
+
+        field.remove_prefix(2);
+
+        std::uintptr_t value {};
+        const auto result = std::from_chars(field.data(), field.data() + field.size(), value, 16);
+        if (result.ec != std::errc {} || result.ptr != field.data() + field.size())
+            return std::nullopt;
+
+        if (first)
+            path.offset = value;
+        else
+            path.offsets.push_back(value);
+
+        if (comma == std::string_view::npos)
+            return path;
+
+        rest.remove_prefix(comma + 1);
+    }
+}
+
+gensokyo::PointerScanner::PointerScanner(impl::Process& process)
+ : PointerScanner(process, Options {})
+{
+}
+
+gensokyo::PointerScanner::PointerScanner(impl::Process& process, Options options)
+ : _process(process),
+   _options(std::move(options))
+{
+}
+
+void gensokyo::PointerScanner::refresh_modules()
+{
+    _modules.clear();
+    _statics.clear();
+
+    for (const auto& module : _process.modules())
+        _modules.push_back({ module.path, module.name, module.base, module.size });
+
+    // listed in the order they're mapped, sorted anyway so a region finds its module by address
+    std::ranges::sort(_modules, {}, &Module::base);
+
+    // the size of a module covers its .bss, including the part past the end of the file that's anonymous memory
+    _process.for_each_region({ .writable = true },
+                             [&](const impl::Region& region)
+                             {
+                                 const auto module = std::ranges::upper_bound(_modules, region.address, {}, &Module::base);
+                                 if (module == _modules.begin())
+                                     return false;
+
+                                 const auto& owner = *std::prev(module);
+                                 if (region.address < owner.base + owner.size && (region.image ? region.path == owner.path : region.path.empty()))
+                                     _statics.push_back({ { region.address, region.size }, static_cast<std::size_t>(std::prev(module) - _modules.begin()) });
+
+                                 return false;
+                             });
+}
+
+const gensokyo::PointerScanner::StaticRange* gensokyo::PointerScanner::find_static(std::uintptr_t address) const noexcept
+{
+    const auto it = std::ranges::upper_bound(_statics, address, {},
+                                             [](const StaticRange& range)
+                                             {
+                                                 return range.region.address;
+                                             });
+
+    if (it == _statics.begin())
+        return nullptr;
+
+    const auto& range = *std::prev(it);
+    return address < range.region.address + range.region.size ? &range : nullptr;
+}
+
+void gensokyo::PointerScanner::snapshot()
+{
+    refresh_modules();
+    _pointers.clear();
+
+    const auto regions = _process.regions(_options.filter);
+    if (regions.empty())
+        return;
+
+    std::vector<impl::MemoryRegion> pieces {};
+    for (const auto& region : regions)
+    {
+        for (std::size_t offset = 0; offset < region.size; offset += snapshot_piece)
+            pieces.push_back({ region.address + offset, std::min(snapshot_piece, region.size - offset) });
+    }
+
+    const auto lowest  = regions.front().address;
+    const auto highest = regions.back().address + regions.back().size;
+
+    // only values that point into the indexed regions can be part of a path
+    const auto points_into = [&](std::uintptr_t value)
+    {
+        if (value < lowest || value >= highest)
+            return false;
+
+        const auto it = std::ranges::upper_bound(regions, value, {}, &impl::Region::address);
+        return it != regions.begin() && value < std::prev(it)->address + std::prev(it)->size;
+    };
+
+    std::vector<std::vector<Pointer>> found(pieces.size());
+    thread_pool.parallel_for(pieces.size(),
+                             [&](std::size_t index)
+                             {
+                                 auto& pointers = found[index];
+
+                                 _process.scan(pieces[index], 0, impl::Process::scan_chunk_size,
+                                               [&](std::span<std::uint8_t> data, std::uintptr_t address)
+                                               {
+                                                   for (std::size_t offset = 0; offset + sizeof(std::uintptr_t) <= data.size(); offset += sizeof(std::uintptr_t))
+                                                   {
+                                                       std::uintptr_t value {};
+                                                       std::memcpy(&value, data.data() + offset, sizeof(value));
+
+                                                       if (points_into(value))
+                                                           pointers.push_back({ value, address + offset });
+                                                   }
+
+                                                   return false;
+                                               });
+
+                                 std::ranges::sort(pointers, {}, &Pointer::value);
+                             });
+
+    std::vector<std::size_t> bounds { 0 };
+    for (auto& pointers : found)
+        bounds.push_back(bounds.back() + pointers.size());
+
+    _pointers.reserve(bounds.back());
+    for (auto& pointers : found)
+    {
+        _pointers.insert(_pointers.end(), pointers.begin(), pointers.end());
+        pointers = {};
+    }
+
+    // every piece is sorted, merge neighbours in pairs until it's one
+    for (std::size_t width = 1; width < found.size(); width *= 2)
+    {
+        thread_pool.parallel_for((found.size() + 2 * width - 1) / (2 * width),
+                                 [&](std::size_t pair)
+                                 {
+                                     const auto first  = pair * 2 * width;
+                                     const auto middle = std::min(first + width, found.size());
+                                     const auto last   = std::min(first + 2 * width, found.size());
+
+                                     std::inplace_merge(_pointers.begin() + bounds[first], _pointers.begin() + bounds[middle], _pointers.begin() + bounds[last],
+                                                        [](const Pointer& a, const Pointer& b)
+                                                        {
+                                                            return a.value < b.value;
+                                                        });
+                                 });
+    }
+}
+
+std::vector<gensokyo::PointerPath> gensokyo::PointerScanner::scan(std::uintptr_t target)
+{
+    if (_pointers.empty())
+        snapshot();
+
+    // a pointer at slot that points offset bytes below an address of the level before
+    struct Link
+    {
+        std::uintptr_t slot {};
+        std::uint32_t child {};
+        std::uintptr_t offset {};
+    };
+
+    struct Edge
+    {
+        std::uint32_t node {};
+        std::uint32_t child {};
+        std::uintptr_t offset {};
+    };
+
+    // nodes are sorted and unique, edges sorted by node, expand has the nodes that aren't static
+    struct Level
+    {
+        std::vector<std::uintptr_t> nodes {};
+        std::vector<Edge> edges {};
+        std::vector<std::uint32_t> expand {};
+    };
+
+    struct Root
+    {
+        std::size_t level {};
+        std::uint32_t node {};
+        const StaticRange* range {};
+    };
+
+    std::vector<Level> levels(1);
+    levels[0].nodes  = { target };
+    levels[0].expand = { 0 };
+
+    std::vector<Root> roots {};
+
+    for (std::size_t depth = 1; depth <= _options.max_depth && !levels.back().expand.empty(); depth++)
+    {
+        const auto& previous = levels.back();
+
+        std::vector<std::vector<Link>> found((previous.expand.size() + level_batch - 1) / level_batch);
+        thread_pool.parallel_for(found.size(),
+                                 [&](std::size_t index)
+                                 {
+                                     const auto first = index * level_batch;
+                                     const auto last  = std::min(first + level_batch, previous.expand.size());
+
+                                     for (auto i = first; i < last; i++)
+                                     {
+                                         const auto child   = previous.expand[i];
+                                         const auto address = previous.nodes[child];
+                                         const auto lowest  = address - std::min<std::uintptr_t>(address, _options.max_offset);
+
+                                         auto it = std::ranges::lower_bound(_pointers, lowest, {}, &Pointer::value);
+                                         for (; it != _pointers.end() && it->value <= address; ++it)
+                                             found[index].push_back({ it->address, child, address - it->value });
+                                     }
+                                 });
+
+        std::vector<Link> links {};
+        for (const auto& batch : found)
+            links.insert(links.end(), batch.begin(), batch.end());
+
+        // an address on an earlier level was expanded there already, going through it again is a detour or a cycle
+        // statics are never expanded, so they're kept as the root of a longer path
+        std::erase_if(links,
+                      [&](const Link& link)
+                      {
+                          return !find_static(link.slot) && std::ranges::any_of(levels,
+                                                     [&](const Level& level)
+                                                     {
+                                                         return std::ranges::binary_search(level.nodes, link.slot);
+                                                     });
+                      });
+
+        std::ranges::sort(links, {}, &Link::slot);
+
+        Level level {};
+        for (const auto& link : links)
+        {
+            if (level.nodes.empty() || level.nodes.back() != link.slot)
+            {
+                level.nodes.push_back(link.slot);
+
+                const auto node = static_cast<std::uint32_t>(level.nodes.size() - 1);
+                if (const auto* range = find_static(link.slot))
+                    roots.push_back({ depth, node, range });
+                else
+                    level.expand.push_back(node);
+            }
+
+            level.edges.push_back({ static_cast<std::uint32_t>(level.nodes.size() - 1), link.child, link.offset });
+        }
+
+        levels.push_back(std::move(level));
+    }
+
+    std::vector<PointerPath> results {};
+    std::vector<std::uintptr_t> offsets {};
+
+    // every way down from a root to the target, roots are in level order so short paths come first
+    const auto walk = [&](const auto& self, const Root& root, std::size_t level, std::uint32_t node) -> void
+    {
+        if (results.size() >= _options.max_results)
+            return;
+
+        if (level == 0)
+        {
+            const auto& module = _modules[root.range->module];
+            results.push_back({ module.name, levels[root.level].nodes[root.node] - module.base, offsets });
+            return;
+        }
+
+        const auto edges = std::ranges::equal_range(levels[level].edges, node, {}, &Edge::node);
+        for (const auto& edge : edges)
+        {
+            offsets.push_back(edge.offset);
+            self(self, root, level - 1, edge.child);
+            offsets.pop_back();
+        }
+    };
+
+    for (const auto& root : roots)
+        walk(walk, root, root.level, root.node);
+
+    std::ranges::sort(results);
+    const auto duplicates = std::ranges::unique(results);
+    results.erase(duplicates.begin(), duplicates.end());
+
+    return results;
+}
+
+std::optional<gensokyo::PointerResolver::Chain> gensokyo::PointerScanner::chain(const PointerPath& path) const
+{
+    // saved paths only have the file name, the first module loaded with it is the one the loader would find too
+    const auto module = std::ranges::find(_modules, path.module, &Module::name);
+    if (module == _modules.end())
+        return std::nullopt;
+
+    return PointerResolver::Chain { module->base + path.offset, path.offsets };
+}
+
+std::optional<std::uintptr_t> gensokyo::PointerScanner::resolve(const PointerPath& path)
+{
+    if (_modules.empty())
+        refresh_modules();
+
+    const auto start = chain(path);
+    if (!start)
+        return std::nullopt;
+
+    const auto result = PointerResolver::resolve(_process, { &*start, 1 }).front();
+    if (!result.ptr)
+        return std::nullopt;
+
+    return result.ptr;
+}
+
+std::vector<gensokyo::PointerPath> gensokyo::PointerScanner::rescan(std::span<const PointerPath> paths, std::uintptr_t target)
+{
+    // the modules of a restarted process are somewhere else
+    refresh_modules();
+
+    std::vector<const PointerPath*> sources {};
+    std::vector<PointerResolver::Chain> chains {};
+    for (const auto& path : paths)
+    {
+        if (auto start = chain(path))
+        {
+            sources.push_back(&path);
+            chains.push_back(std::move(*start));
+        }
+    }
+
+    // all paths go down a level together
+    const auto addresses = PointerResolver::resolve(_process, chains);
+
+    std::vector<PointerPath> results {};
+    for (std::size_t i = 0; i < addresses.size(); i++)
+    {
+        if (addresses[i].ptr == target)
+            results.push_back(*sources[i]);
+    }
+
+    return results;
+}
+
+void gensokyo::PointerScanner::save(const std::filesystem::path& file, std::span<const PointerPath> paths)
+{
+    std::ofstream stream(file);
+    if (!stream)
+        throw std::runtime_error(fmt::format("Failed to open {}", file.string()));
+
+    for (const auto& path : paths)
+        stream << path.to_string() << '\n';
+}
+
+std::vector<gensokyo::PointerPath> gensokyo::PointerScanner::load(const std::filesystem::path& file)
+{
+    std::ifstream stream(file);
+    if (!stream)
+        throw std::runtime_error(fmt::format("Failed to open {}", file.string()));
+
+    std::vector<PointerPath> paths {};
+    for (std::string line; std::getline(stream, line);)
+    {
+        // a file that went through windows has \r at the end of every line
+        while (!line.empty() && std::isspace(static_cast<unsigned char>(line.back())))
+            line.pop_back();
+
+        if (line.empty())
+            continue;
+
+        auto path = PointerPath::parse(line);
+        if (!path)
+            throw std::runtime_error(fmt::format("Invalid pointer path \"{}\" in {}", line, file.string()));
+
+        paths.push_back(std::move(*path));
+    }
+
+    return paths;
+}
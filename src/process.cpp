@@ -1,5 +1,83 @@
 #include <gensokyo.hpp>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <ranges>
+
+namespace
+{
+    // reading a few unused bytes in between is cheaper than another call into the kernel
+    constexpr std::size_t coalesce_gap  = 512;
+    constexpr std::size_t coalesce_span = 64 * 1024;
+
+    /*
+     * A read that runs on the thread pool, or on the waiting thread when no worker took it yet
+     * Waiting on a pool task from inside another pool task could otherwise wait forever for a free worker
+     */
+    class PendingRead
+    {
+        struct State
+        {
+            std::atomic<bool> claimed {};
+            std::atomic<bool> done {};
+            std::size_t length {};
+        };
+
+        std::shared_ptr<State> _state {};
+        std::function<std::size_t()> _read {};
+
+      public:
+        PendingRead() = default;
+        PendingRead(const PendingRead&)            = delete;
+        PendingRead& operator=(const PendingRead&) = delete;
+
+        // the read writes into a buffer owned by the scan, so it's finished before the scan returns or unwinds, or never runs at all
+        ~PendingRead()
+        {
+            if (_state && _state->claimed.exchange(true))
+                _state->done.wait(false);
+        }
+
+        void start(std::function<std::size_t()> read)
+        {
+            _state = std::make_shared<State>();
+            _read  = std::move(read);
+
+            gensokyo::thread_pool.submit(
+              [state = _state, this]
+              {
+                  // once claimed by the pool, the scan waits for it, so this is still alive
+                  if (state->claimed.exchange(true))
+                      return;
+
+                  state->length = _read();
+                  state->done   = true;
+                  state->done.notify_one();
+              });
+        }
+
+        [[nodiscard]] bool started() const noexcept
+        {
+            return _state != nullptr;
+        }
+
+        std::size_t wait()
+        {
+            const auto state = std::exchange(_state, nullptr);
+            if (!state->claimed.exchange(true))
+                return _read();
+
+            state->done.wait(false);
+            return state->length;
+        }
+    };
+}
+
 bool gensokyo::impl::Process::read(std::uintptr_t address, void* buffer, std::size_t size)
 {
     return read_impl(address, buffer, size);
@@ -9,3 +87,318 @@ bool gensokyo::impl::Process::write(std::uintptr_t address, void* buffer, std::s
 {
     return write_impl(address, buffer, size);
 }
+
+std::size_t gensokyo::impl::Process::read_many(std::span<ReadRequest> requests)
+{
+    for (auto& request : requests)
+        request.success = false;
+
+    read_many_impl(requests);
+
+    return static_cast<std::size_t>(std::ranges::count(requests, true, &ReadRequest::success));
+}
+
+void gensokyo::impl::Process::read_many_impl(std::span<ReadRequest> requests)
+{
+    std::vector<ReadRequest*> sorted {};
+    sorted.reserve(requests.size());
+    for (auto& request : requests)
+    {
+        if (request.size == 0)
+            request.success = true;
+        else
+            sorted.push_back(&request);
+    }
+
+    std::ranges::sort(sorted, {}, &ReadRequest::address);
+
+    std::vector<std::uint8_t> scratch {};
+    for (std::size_t first = 0, last; first < sorted.size(); first = last)
+    {
+        const auto start = sorted[first]->address;
+        auto end         = start + sorted[first]->size;
+
+        for (last = first + 1; last < sorted.size(); last++)
+        {
+            const auto& next     = *sorted[last];
+            const auto next_end = std::max(end, next.address + next.size);
+            if (next.address > end + coalesce_gap || next_end - start > coalesce_span)
+                break;
+
+            end = next_end;
+        }
+
+        if (last - first > 1)
+        {
+            scratch.resize(end - start);
+            if (read_impl(start, scratch.data(), scratch.size()))
+            {
+                for (auto i = first; i < last; i++)
+                {
+                    std::memcpy(sorted[i]->buffer, scratch.data() + (sorted[i]->address - start), sorted[i]->size);
+                    sorted[i]->success = true;
+                }
+
+                continue;
+            }
+        }
+
+        for (auto i = first; i < last; i++)
+            sorted[i]->success = read_impl(sorted[i]->address, sorted[i]->buffer, sorted[i]->size);
+    }
+}
+
+std::size_t gensokyo::impl::Process::write_many(std::span<WriteRequest> requests)
+{
+    for (auto& request : requests)
+        request.success = false;
+
+    write_many_impl(requests);
+
+    return static_cast<std::size_t>(std::ranges::count(requests, true, &WriteRequest::success));
+}
+
+void gensokyo::impl::Process::write_many_impl(std::span<WriteRequest> requests)
+{
+    std::vector<WriteRequest*> sorted {};
+    sorted.reserve(requests.size());
+    for (auto& request : requests)
+    {
+        if (request.size == 0)
+            request.success = true;
+        else
+            sorted.push_back(&request);
+    }
+
+    // stable, so requests at the same address stay in the order they were given
+    std::ranges::stable_sort(sorted, {}, &WriteRequest::address);
+
+    std::vector<WriteRequest*> group {};
+    std::vector<std::uint8_t> scratch {};
+    for (std::size_t first = 0, last; first < sorted.size(); first = last)
+    {
+        const auto start = sorted[first]->address;
+        auto end         = start + sorted[first]->size;
+
+        for (last = first + 1; last < sorted.size(); last++)
+        {
+            const auto& next    = *sorted[last];
+            const auto next_end = std::max(end, next.address + next.size);
+            if (next.address > end || next_end - start > coalesce_span)
+                break;
+
+            end = next_end;
+        }
+
+        // back in the order they were given, so copying them in turn lets the later one win
+        group.assign(sorted.begin() + static_cast<std::ptrdiff_t>(first), sorted.begin() + static_cast<std::ptrdiff_t>(last));
+        std::ranges::sort(group);
+
+        if (group.size() > 1)
+        {
+            scratch.resize(end - start);
+            for (const auto* request : group)
+                std::memcpy(scratch.data() + (request->address - start), request->buffer, request->size);
+
+            if (write_impl(start, scratch.data(), scratch.size()))
+            {
+                for (auto* request : group)
+                    request->success = true;
+
+                continue;
+            }
+        }
+
+        for (auto* request : group)
+            request->success = write_impl(request->address, const_cast<void*>(request->buffer), request->size);
+    }
+}
+
+void gensokyo::impl::Process::for_each_region(const RegionFilter& filter, const RegionCallbackFn& func)
+{
+    enumerate_regions(
+      [&](const Region& region)
+      {
+          return filter.matches(region) && func(region);
+      });
+}
+
+std::vector<gensokyo::impl::Region> gensokyo::impl::Process::regions(const RegionFilter& filter)
+{
+    std::vector<Region> results {};
+    for_each_region(filter,
+                    [&](const Region& region)
+                    {
+                        results.push_back(region);
+                        return false;
+                    });
+
+    return results;
+}
+
+std::vector<gensokyo::impl::ModuleInfo> gensokyo::impl::Process::modules()
+{
+    /*
+     * Every file mapped as an image, from the start of its first mapping to the end of its last
+     * A mapping only continues the latest entry of its file when it comes after it further into the file, so a file that's mapped twice is
+     * two entries rather than one covering everything in between
+     */
+    std::vector<CachedModule> mapped {};
+    std::vector<std::size_t> offsets {};
+    for_each_region({ .image = true },
+                    [&](const Region& region)
+                    {
+                        const auto latest = std::ranges::find(mapped | std::views::reverse, region.path, &CachedModule::path).base();
+                        if (latest != mapped.begin())
+                        {
+                            const auto index = static_cast<std::size_t>(latest - mapped.begin() - 1);
+                            auto& entry      = mapped[index];
+                            if (region.offset != 0 && region.offset > offsets[index] && region.address >= entry.address + entry.size)
+                            {
+                                entry.size     = region.address + region.size - entry.address;
+                                offsets[index] = region.offset;
+                                return false;
+                            }
+                        }
+
+                        mapped.push_back({ region.path, region.address, region.size });
+                        offsets.push_back(region.offset);
+                        return false;
+                    });
+
+    std::lock_guard lock(_module_mutex);
+
+    // the same file at the same place with the same size is taken as the same module
+    std::vector<ModuleInfo> unknown {};
+    std::vector<std::size_t> owners {};
+    for (std::size_t i = 0; i < mapped.size(); i++)
+    {
+        const auto cached = std::ranges::find_if(_module_cache,
+                                                 [&](const CachedModule& entry)
+                                                 {
+                                                     return entry.address == mapped[i].address && entry.size == mapped[i].size && entry.path == mapped[i].path;
+                                                 });
+
+        if (cached != _module_cache.end())
+        {
+            mapped[i].module = std::move(cached->module);
+            continue;
+        }
+
+        unknown.push_back({ std::filesystem::path(mapped[i].path).filename().string(), mapped[i].path, mapped[i].address, mapped[i].size });
+        owners.push_back(i);
+    }
+
+    if (!unknown.empty())
+    {
+        const auto parsed = read_module_headers(unknown);
+        for (std::size_t i = 0; i < unknown.size(); i++)
+        {
+            if (parsed[i])
+                mapped[owners[i]].module = std::move(unknown[i]);
+        }
+    }
+
+    std::vector<ModuleInfo> results {};
+    for (const auto& entry : mapped)
+    {
+        if (entry.module)
+            results.push_back(*entry.module);
+    }
+
+    // modules that went away are dropped with the rest
+    _module_cache = std::move(mapped);
+    return results;
+}
+
+void gensokyo::impl::Process::scan(const MemoryRegion& region, std::size_t overlap, std::size_t chunk_size, const ChunkCallbackFn& func)
+{
+    if (region.size == 0 || chunk_size == 0)
+        return;
+
+    // every buffer has room in front for the bytes carried over from the previous chunk
+    std::array<std::vector<std::uint8_t>, 2> buffers { std::vector<std::uint8_t>(overlap + chunk_size), std::vector<std::uint8_t>(overlap + chunk_size) };
+
+    const auto read_chunk = [this, &region, chunk_size](std::uint8_t* buffer, std::size_t offset) -> std::size_t
+    {
+        const auto length = std::min(chunk_size, region.size - offset);
+        return read(region.address + offset, buffer, length) ? length : 0;
+    };
+
+    std::size_t offset  = 0;
+    std::size_t carried = 0;
+    std::size_t length  = read_chunk(buffers[0].data() + overlap, 0);
+
+    for (std::size_t current = 0;; current ^= 1)
+    {
+        auto& buffer = buffers[current];
+        auto& next   = buffers[current ^ 1];
+
+        PendingRead pending {};
+        std::size_t next_carried = 0;
+
+        const auto next_offset = offset + chunk_size;
+        if (next_offset < region.size)
+        {
+            if (length)
+            {
+                next_carried = std::min(overlap, carried + length);
+                std::memcpy(next.data() + overlap - next_carried, buffer.data() + overlap + length - next_carried, next_carried);
+            }
+
+            pending.start(
+              [&read_chunk, destination = next.data() + overlap, next_offset]
+              {
+                  return read_chunk(destination, next_offset);
+              });
+        }
+
+        if (length && func({ buffer.data() + overlap - carried, carried + length }, region.address + offset - carried))
+            return;
+
+        if (!pending.started())
+            return;
+
+        length  = pending.wait();
+        carried = length ? next_carried : 0;
+        offset  = next_offset;
+    }
+}
+
+gensokyo::Address gensokyo::impl::Process::find(const MemoryRegion& region, pattern::impl::PatternView pattern, std::size_t chunk_size)
+{
+    if (pattern.empty())
+        return {};
+
+    gensokyo::Address found {};
+    scan(region, pattern.size() - 1, chunk_size,
+         [&](std::span<std::uint8_t> data, std::uintptr_t address)
+         {
+             const auto result = pattern::find(data, pattern);
+             if (!result.ptr)
+                 return false;
+
+             found = address + (result.ptr - reinterpret_cast<std::uintptr_t>(data.data()));
+             return true;
+         });
+
+    return found;
+}
+
+std::vector<gensokyo::Address> gensokyo::impl::Process::find_all(const MemoryRegion& region, pattern::impl::PatternView pattern, std::size_t chunk_size)
+{
+    std::vector<gensokyo::Address> results {};
+    if (pattern.empty())
+        return results;
+
+    scan(region, pattern.size() - 1, chunk_size,
+         [&](std::span<std::uint8_t> data, std::uintptr_t address)
+         {
+             for (const auto result : pattern::find_all(data, pattern))
+                 results.push_back(address + (result.ptr - reinterpret_cast<std::uintptr_t>(data.data())));
+
+             return false;
+         });
+
+    return results;
+}
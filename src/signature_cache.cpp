@@ -0,0 +1,157 @@
+#include <gensokyo.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t file_size(std::uint64_t capacity)
+    {
+        return sizeof(gensokyo::SignatureCache::Header) + capacity * sizeof(gensokyo::SignatureCache::Entry);
+    }
+
+    constexpr std::uint64_t mix(std::uint64_t value)
+    {
+        value ^= value >> 33;
+        value *= 0xFF51AFD7ED558CCD;
+        value ^= value >> 33;
+        value *= 0xC4CEB9FE1A85EC53;
+        value ^= value >> 33;
+        return value;
+    }
+}
+
+gensokyo::SignatureCache::SignatureCache(const std::filesystem::path& path)
+ : _file(path, sizeof(Header))
+{
+    const auto& current = header();
+
+    const auto valid = current.magic == magic && current.version == version && std::has_single_bit(current.capacity) &&
+                       _file.size() == file_size(current.capacity) && current.count < current.capacity;
+
+    if (!valid)
+    {
+        reset(initial_capacity);
+        return;
+    }
+
+    // a file left behind half written can hold more entries than its count says, probing needs a free slot to stop at
+    const auto table    = entries();
+    const auto occupied = std::count_if(table, table + current.capacity,
+                                        [](const Entry& entry)
+                                        {
+                                            return entry.size != 0;
+                                        });
+
+    if (static_cast<std::uint64_t>(occupied) != current.count)
+        reset(initial_capacity);
+}
+
+void gensokyo::SignatureCache::reset(std::uint64_t capacity)
+{
+    _file.resize(sizeof(Header));
+    _file.resize(file_size(capacity));
+
+    header() = { magic, version, capacity, 0, 0 };
+}
+
+gensokyo::SignatureCache::Entry* gensokyo::SignatureCache::slot(const impl::ModuleIdentity& module, std::uint64_t pattern) const noexcept
+{
+    const auto mask  = header().capacity - 1;
+    const auto table = entries();
+
+    // linear probing, stops at the entry itself or the first free slot, the table is never full
+    for (auto index = mix(module.build ^ mix(module.size ^ mix(pattern))) & mask;; index = (index + 1) & mask)
+    {
+        auto& entry = table[index];
+        if (entry.size == 0 || (entry.build == module.build && entry.size == module.size && entry.pattern == pattern))
+            return &entry;
+    }
+}
+
+std::optional<std::uintptr_t> gensokyo::SignatureCache::lookup(const impl::ModuleIdentity& module, std::uint64_t pattern) const noexcept
+{
+    if (module.size == 0)
+        return std::nullopt;
+
+    if (const auto entry = slot(module, pattern); entry->size != 0)
+        return static_cast<std::uintptr_t>(entry->offset);
+
+    return std::nullopt;
+}
+
+void gensokyo::SignatureCache::store(const impl::ModuleIdentity& module, std::uint64_t pattern, std::uintptr_t offset)
+{
+    if (module.size == 0)
+        throw std::invalid_argument("Module without identity can't be cached");
+
+    if (const auto entry = slot(module, pattern); entry->size != 0)
+    {
+        entry->offset = offset;
+        return;
+    }
+
+    // keep the load factor under 3/4, growing copies the entries out and inserts them into the bigger table
+    if ((header().count + 1) * 4 > header().capacity * 3)
+    {
+        const std::vector<Entry> old(entries(), entries() + header().capacity);
+        reset(header().capacity * 2);
+
+        for (const auto& entry : old)
+        {
+            if (entry.size == 0)
+                continue;
+
+            *slot({ entry.build, entry.size }, entry.pattern) = entry;
+            header().count++;
+        }
+    }
+
+    *slot(module, pattern) = { module.build, module.size, pattern, offset };
+    header().count++;
+}
+
+void gensokyo::SignatureCache::clear()
+{
+    reset(initial_capacity);
+}
+
+std::uint64_t gensokyo::SignatureCache::hash(pattern::impl::PatternView pattern) noexcept
+{
+    std::uint64_t hash = 0xCBF29CE484222325;
+    for (const auto& byte : pattern)
+    {
+        hash = (hash ^ byte.byte) * 0x100000001B3;
+        hash = (hash ^ byte.mask) * 0x100000001B3;
+    }
+
+    hash = (hash ^ pattern.size()) * 0x100000001B3;
+    return hash ? hash : 1;
+}
+
+gensokyo::Address gensokyo::SignatureCache::find(impl::Module& module, pattern::impl::PatternView pattern)
+{
+    const auto& identity = module.identity();
+    const auto key       = hash(pattern);
+
+    if (const auto offset = lookup(identity, key))
+    {
+        const auto address = module.base() + *offset;
+
+        for (const auto& segment : module.get_segments())
+        {
+            if (address < segment.address || segment.data.size() < pattern.size() || address - segment.address > segment.data.size() - pattern.size())
+                continue;
+
+            if (pattern::impl::matches(segment.data.data() + (address - segment.address), pattern))
+                return address;
+        }
+    }
+
+    const auto result = module.find(pattern);
+    if (result.ptr)
+        store(identity, key, result.ptr - module.base());
+
+    return result;
+}
@@ -0,0 +1,398 @@
+#include <gensokyo.hpp>
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+    // pages read per read_many in a next scan
+    constexpr std::size_t batch_pages = 256;
+
+    template <typename T>
+    T load(const std::uint8_t* data)
+    {
+        T value {};
+        std::memcpy(&value, data, sizeof(T));
+        return value;
+    }
+
+    // append the index of every slot in data that holds value, a slot only matches when all of its bytes do
+    template <typename SIMD, typename T>
+    void match_slots_simd(const std::uint8_t* data, std::size_t slots, T value, std::vector<std::uint16_t>& offsets)
+    {
+        using mask_type                   = typename SIMD::mask_type;
+        constexpr std::size_t simd_length = SIMD::simd_length;
+
+        // the first byte of every slot in a register
+        constexpr auto slot_starts = []
+        {
+            mask_type mask {};
+            for (std::size_t i = 0; i < simd_length; i += sizeof(T))
+                mask |= mask_type(1) << i;
+
+            return mask;
+        }();
+
+        std::array<std::uint8_t, simd_length> repeated {};
+        for (std::size_t i = 0; i < simd_length; i += sizeof(T))
+            std::memcpy(repeated.data() + i, &value, sizeof(T));
+
+        const auto needle = SIMD::load_unaligned(repeated.data());
+        const auto size   = slots * sizeof(T);
+
+        std::size_t offset = 0;
+        for (; offset + simd_length <= size; offset += simd_length)
+        {
+            auto mask = SIMD::cmpeq_mask(SIMD::load_unaligned(data + offset), needle);
+
+            // fold the bytes of a slot onto its first byte, slots never cross a register
+            if constexpr (sizeof(T) >= 2)
+                mask &= mask >> 1;
+            if constexpr (sizeof(T) >= 4)
+                mask &= mask >> 2;
+            if constexpr (sizeof(T) >= 8)
+                mask &= mask >> 4;
+
+            for (mask &= slot_starts; mask; mask &= mask - 1)
+                offsets.push_back(static_cast<std::uint16_t>((offset + std::countr_zero(mask)) / sizeof(T)));
+        }
+
+        for (; offset < size; offset += sizeof(T))
+        {
+            if (load<T>(data + offset) == value)
+                offsets.push_back(static_cast<std::uint16_t>(offset / sizeof(T)));
+        }
+    }
+
+    template <typename T>
+    void match_slots(const std::uint8_t* data, std::size_t slots, T value, std::vector<std::uint16_t>& offsets)
+    {
+        const auto arch = gensokyo::cpu.get_arch();
+#if defined(GENSOKYO_SIMD_AVX512)
+        if (arch == gensokyo::CPUArch::AVX512)
+            return match_slots_simd<gensokyo::simd::iAVX512>(data, slots, value, offsets);
+#endif
+        if (arch == gensokyo::CPUArch::AVX512 || arch == gensokyo::CPUArch::AVX2)
+            return match_slots_simd<gensokyo::simd::iAVX2>(data, slots, value, offsets);
+
+        if (arch == gensokyo::CPUArch::SSE)
+            return match_slots_simd<gensokyo::simd::iSSE>(data, slots, value, offsets);
+
+        for (std::size_t slot = 0; slot < slots; slot++)
+        {
+            if (load<T>(data + slot * sizeof(T)) == value)
+                offsets.push_back(static_cast<std::uint16_t>(slot));
+        }
+    }
+}
+
+template <typename T>
+gensokyo::ValueScanner<T>::ValueScanner(impl::Process& process, impl::RegionFilter filter, T epsilon)
+ : _process(process),
+   _filter(filter),
+   _epsilon(epsilon)
+{
+}
+
+template <typename T>
+bool gensokyo::ValueScanner<T>::equal(T a, T b) const noexcept
+{
+    if constexpr (std::is_floating_point_v<T>)
+        return a == b || std::abs(a - b) <= _epsilon;
+    else
+        return a == b;
+}
+
+template <typename T>
+std::size_t gensokyo::ValueScanner<T>::first_scan(T value)
+{
+    reset();
+
+    for (const auto& region : _process.regions(_filter))
+    {
+        _process.scan(region, 0, impl::Process::scan_chunk_size,
+                      [&](std::span<std::uint8_t> data, std::uintptr_t address)
+                      {
+                          for (std::size_t offset = 0; offset < data.size(); offset += page_size)
+                          {
+                              const auto* page = data.data() + offset;
+                              const auto slots = std::min(page_size, data.size() - offset) / sizeof(T);
+                              const auto first = _offsets.size();
+
+                              // epsilon makes floating point values unsuitable for a bytewise compare
+                              if constexpr (std::is_floating_point_v<T>)
+                              {
+                                  for (std::size_t slot = 0; slot < slots; slot++)
+                                  {
+                                      if (equal(load<T>(page + slot * sizeof(T)), value))
+                                          _offsets.push_back(static_cast<std::uint16_t>(slot));
+                                  }
+                              }
+                              else
+                                  match_slots(page, slots, value, _offsets);
+
+                              const auto count = _offsets.size() - first;
+                              if (count == 0)
+                                  continue;
+
+                              for (auto i = first; i < _offsets.size(); i++)
+                                  _values.push_back(load<T>(page + _offsets[i] * sizeof(T)));
+
+                              if (count == slots_per_page)
+                                  _offsets.resize(first);
+
+                              _pages.push_back({ address + offset, static_cast<std::uint32_t>(count) });
+                              _count += count;
+                          }
+
+                          return false;
+                      });
+    }
+
+    // matches are usually few, copying them is cheap next to the growth slack
+    _pages.shrink_to_fit();
+    _values.shrink_to_fit();
+    _offsets.shrink_to_fit();
+
+    return _count;
+}
+
+template <typename T>
+std::size_t gensokyo::ValueScanner<T>::first_scan_unknown()
+{
+    reset();
+
+    for (const auto& region : _process.regions(_filter))
+    {
+        _process.scan(region, 0, impl::Process::scan_chunk_size,
+                      [&](std::span<std::uint8_t> data, std::uintptr_t address)
+                      {
+                          for (std::size_t offset = 0; offset < data.size(); offset += page_size)
+                          {
+                              const auto slots = std::min(page_size, data.size() - offset) / sizeof(T);
+                              if (slots == 0)
+                                  continue;
+
+                              // only the last page of an odd sized region needs its slots listed
+                              if (slots != slots_per_page)
+                              {
+                                  for (std::size_t slot = 0; slot < slots; slot++)
+                                      _offsets.push_back(static_cast<std::uint16_t>(slot));
+                              }
+
+                              const auto first = _values.size();
+                              _values.resize(first + slots);
+                              std::memcpy(_values.data() + first, data.data() + offset, slots * sizeof(T));
+
+                              _pages.push_back({ address + offset, static_cast<std::uint32_t>(slots) });
+                              _count += slots;
+                          }
+
+                          return false;
+                      });
+    }
+
+    return _count;
+}
+
+template <typename T>
+template <typename F>
+std::size_t gensokyo::ValueScanner<T>::narrow(F&& keep)
+{
+    std::vector<std::uint8_t> buffer(batch_pages * page_size);
+    std::vector<impl::ReadRequest> requests {};
+    requests.reserve(batch_pages);
+
+    // values only ever shrink and are compacted in place, a page where every slot was a candidate may need its offsets listed now
+    std::vector<std::uint16_t> offsets {};
+
+    std::size_t offset_in {};
+    std::size_t value_in {};
+    std::size_t value_out {};
+    std::size_t page_out {};
+    _count = 0;
+
+    for (std::size_t first = 0; first < _pages.size(); first += batch_pages)
+    {
+        const auto last = std::min(first + batch_pages, _pages.size());
+
+        // one read per page, from its first to its last candidate
+        requests.clear();
+        for (auto i = first, cursor = offset_in; i < last; i++)
+        {
+            const auto& page = _pages[i];
+
+            std::size_t low  = 0;
+            std::size_t high = slots_per_page - 1;
+            if (page.count != slots_per_page)
+            {
+                low  = _offsets[cursor];
+                high = _offsets[cursor + page.count - 1];
+                cursor += page.count;
+            }
+
+            requests.push_back({ page.address + low * sizeof(T), buffer.data() + (i - first) * page_size + low * sizeof(T), (high - low + 1) * sizeof(T) });
+        }
+
+        _process.read_many(requests);
+
+        for (auto i = first; i < last; i++)
+        {
+            const auto page  = _pages[i];
+            const auto dense = page.count == slots_per_page;
+            const auto* data = buffer.data() + (i - first) * page_size;
+            const auto begin = offsets.size();
+
+            // a page that can't be read anymore loses all of its candidates
+            if (requests[i - first].success)
+            {
+                for (std::size_t j = 0; j < page.count; j++)
+                {
+                    const auto slot    = dense ? static_cast<std::uint16_t>(j) : _offsets[offset_in + j];
+                    const auto current = load<T>(data + slot * sizeof(T));
+                    if (!keep(current, _values[value_in + j]))
+                        continue;
+
+                    offsets.push_back(slot);
+                    _values[value_out++] = current;
+                }
+            }
+
+            value_in += page.count;
+            if (!dense)
+                offset_in += page.count;
+
+            const auto kept = offsets.size() - begin;
+            if (kept == 0)
+                continue;
+
+            if (kept == slots_per_page)
+                offsets.resize(begin);
+
+            _pages[page_out++] = { page.address, static_cast<std::uint32_t>(kept) };
+            _count += kept;
+        }
+    }
+
+    _pages.resize(page_out);
+    _values.resize(value_out);
+    _offsets = std::move(offsets);
+
+    // a scan usually drops most candidates, give the memory back
+    if (_values.size() < _values.capacity() / 2)
+    {
+        _pages.shrink_to_fit();
+        _values.shrink_to_fit();
+        _offsets.shrink_to_fit();
+    }
+
+    return _count;
+}
+
+template <typename T>
+std::size_t gensokyo::ValueScanner<T>::next_scan(T value)
+{
+    return narrow(
+      [&](T current, T)
+      {
+          return equal(current, value);
+      });
+}
+
+template <typename T>
+std::size_t gensokyo::ValueScanner<T>::next_scan(ScanCompare compare)
+{
+    switch (compare)
+    {
+        case ScanCompare::Changed:
+            return narrow(
+              [&](T current, T previous)
+              {
+                  return !equal(current, previous);
+              });
+        case ScanCompare::Unchanged:
+            return narrow(
+              [&](T current, T previous)
+              {
+                  return equal(current, previous);
+              });
+        case ScanCompare::Increased:
+            return narrow(
+              [&](T current, T previous)
+              {
+                  return current > previous && !equal(current, previous);
+              });
+        case ScanCompare::Decreased:
+            return narrow(
+              [&](T current, T previous)
+              {
+                  return current < previous && !equal(current, previous);
+              });
+    }
+
+    throw std::invalid_argument("Unknown ScanCompare");
+}
+
+template <typename T>
+void gensokyo::ValueScanner<T>::reset()
+{
+    _pages   = {};
+    _offsets = {};
+    _values  = {};
+    _count   = 0;
+}
+
+template <typename T>
+void gensokyo::ValueScanner<T>::for_each(const std::function<bool(gensokyo::Address address, T value)>& func) const
+{
+    std::size_t offset_index {};
+    std::size_t value_index {};
+
+    for (const auto& page : _pages)
+    {
+        const auto dense = page.count == slots_per_page;
+        for (std::size_t j = 0; j < page.count; j++)
+        {
+            const auto slot = dense ? j : _offsets[offset_index + j];
+            if (func(page.address + slot * sizeof(T), _values[value_index + j]))
+                return;
+        }
+
+        value_index += page.count;
+        if (!dense)
+            offset_index += page.count;
+    }
+}
+
+template <typename T>
+std::vector<typename gensokyo::ValueScanner<T>::Result> gensokyo::ValueScanner<T>::results(std::size_t max_count) const
+{
+    std::vector<Result> results {};
+    if (max_count == 0)
+        return results;
+
+    results.reserve(std::min(max_count, _count));
+
+    for_each(
+      [&](gensokyo::Address address, T value)
+      {
+          results.push_back({ address, value });
+          return results.size() >= max_count;
+      });
+
+    return results;
+}
+
+template class gensokyo::ValueScanner<std::int8_t>;
+template class gensokyo::ValueScanner<std::uint8_t>;
+template class gensokyo::ValueScanner<std::int16_t>;
+template class gensokyo::ValueScanner<std::uint16_t>;
+template class gensokyo::ValueScanner<std::int32_t>;
+template class gensokyo::ValueScanner<std::uint32_t>;
+template class gensokyo::ValueScanner<std::int64_t>;
+template class gensokyo::ValueScanner<std::uint64_t>;
+template class gensokyo::ValueScanner<float>;
+template class gensokyo::ValueScanner<double>;
@@ -0,0 +1,11 @@
+#include <gensokyo.hpp>
+
+std::uint32_t gensokyo::LocalProcess::get_pid()
+{
+    return GetCurrentProcessId();
+}
+
+void gensokyo::LocalProcess::enumerate_regions(const RegionCallbackFn& func)
+{
+    WinProcess::for_each_mapping(GetCurrentProcess(), func);
+}
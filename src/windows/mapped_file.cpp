@@ -0,0 +1,90 @@
+#include <gensokyo.hpp>
+
+#include <Windows.h>
+#include <stdexcept>
+
+gensokyo::impl::MappedFile::MappedFile(const std::filesystem::path& path, std::size_t min_size)
+{
+    const auto file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw std::runtime_error(fmt::format("Failed to open {}", path.string()));
+
+    _file = reinterpret_cast<std::intptr_t>(file);
+
+    LARGE_INTEGER size {};
+    if (!GetFileSizeEx(file, &size))
+    {
+        close();
+        throw std::runtime_error(fmt::format("Failed to stat {}", path.string()));
+    }
+
+    try
+    {
+        resize(std::max(static_cast<std::size_t>(size.QuadPart), min_size));
+    }
+    catch (...)
+    {
+        close();
+        throw;
+    }
+}
+
+void gensokyo::impl::MappedFile::map(std::size_t size)
+{
+    // the mapping size sets the file size, so it has to be created again whenever the file grows
+    const auto mapping = CreateFileMappingW(reinterpret_cast<HANDLE>(_file), nullptr, PAGE_READWRITE, static_cast<DWORD>(static_cast<std::uint64_t>(size) >> 32),
+                                            static_cast<DWORD>(size), nullptr);
+    if (!mapping)
+        throw std::runtime_error("Failed to map file");
+
+    const auto data = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (!data)
+    {
+        CloseHandle(mapping);
+        throw std::runtime_error("Failed to map file");
+    }
+
+    _mapping = mapping;
+    _data    = static_cast<std::uint8_t*>(data);
+    _size    = size;
+}
+
+void gensokyo::impl::MappedFile::unmap() noexcept
+{
+    if (_data)
+        UnmapViewOfFile(_data);
+
+    if (_mapping)
+        CloseHandle(_mapping);
+
+    _mapping = nullptr;
+    _data    = nullptr;
+    _size    = 0;
+}
+
+void gensokyo::impl::MappedFile::resize(std::size_t size)
+{
+    if (_file == -1)
+        throw std::runtime_error("Resizing a closed file");
+
+    unmap();
+
+    // shrinking needs an explicit end of file, growing is done by the mapping itself
+    LARGE_INTEGER position {};
+    position.QuadPart = static_cast<LONGLONG>(size);
+    if (!SetFilePointerEx(reinterpret_cast<HANDLE>(_file), position, nullptr, FILE_BEGIN) || !SetEndOfFile(reinterpret_cast<HANDLE>(_file)))
+        throw std::runtime_error("Failed to resize file");
+
+    if (size)
+        map(size);
+}
+
+void gensokyo::impl::MappedFile::close() noexcept
+{
+    unmap();
+
+    if (_file != -1)
+        CloseHandle(reinterpret_cast<HANDLE>(_file));
+
+    _file = -1;
+}
@@ -2,6 +2,9 @@
 
 #include <minwindef.h>
 #include <Windows.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
 #include <stdexcept>
 
 gensokyo::impl::Module::Module(const std::string_view str, const FunctionCallbackFn& func)
@@ -27,9 +30,11 @@ void gensokyo::impl::Module::get_module_nfo(std::string_view mod, const Function
     if (nt_header->Signature != IMAGE_NT_SIGNATURE)
         throw std::runtime_error("Invalid nt signature");
 
-    this->_handle      = handle;
+    // GetModuleHandleA takes no reference, there's nothing to give back
+    this->_handle      = std::shared_ptr<void>(handle, [](void*) {});
     this->_baseAddress = reinterpret_cast<uintptr_t>(handle);
     this->_size        = nt_header->OptionalHeader.SizeOfImage;
+    this->_identity    = { (static_cast<std::uint64_t>(nt_header->FileHeader.TimeDateStamp) << 32) | nt_header->OptionalHeader.CheckSum, _size };
     auto section       = IMAGE_FIRST_SECTION(nt_header);
 
     for (auto i = 0; i < nt_header->FileHeader.NumberOfSections; i++, section++)
@@ -59,10 +64,97 @@ void* gensokyo::impl::Module::get_proc(const std::string_view proc_name)
     if (!this->_handle)
         throw std::runtime_error("Invalid module handle when getting ProcAddress");
 
-    if (const auto address = GetProcAddress(static_cast<HMODULE>(_handle), proc_name.data()); address)
+    if (const auto address = GetProcAddress(static_cast<HMODULE>(_handle.get()), proc_name.data()); address)
     {
         return address;
     }
 
     throw std::runtime_error(fmt::format("Cannot get proc with name {}", proc_name));
 }
+
+std::vector<bool> gensokyo::impl::Process::read_module_headers(std::span<ModuleInfo> modules)
+{
+    // the dos, nt and section headers fit in SizeOfHeaders which is at most a page for almost every image
+    constexpr std::size_t header_size = 0x1000;
+
+    std::vector<bool> parsed(modules.size());
+    std::vector<std::uint8_t> pages(modules.size() * header_size);
+    std::vector<ReadRequest> requests {};
+    for (std::size_t i = 0; i < modules.size(); i++)
+        requests.push_back({ modules[i].base, pages.data() + i * header_size, std::min(header_size, modules[i].size) });
+
+    read_many(requests);
+
+    std::vector<IMAGE_NT_HEADERS> nt_headers(modules.size());
+    std::vector<std::vector<IMAGE_SECTION_HEADER>> tables(modules.size());
+    std::vector<ReadRequest> table_requests {};
+    std::vector<std::size_t> owners {};
+    for (std::size_t i = 0; i < modules.size(); i++)
+    {
+        // data files mapped as images by LoadLibraryEx and such have no usable headers
+        IMAGE_DOS_HEADER dos_header {};
+        if (!requests[i].success || requests[i].size < sizeof(dos_header))
+            continue;
+
+        const auto bytes = static_cast<const std::uint8_t*>(requests[i].buffer);
+        std::memcpy(&dos_header, bytes, sizeof(dos_header));
+
+        auto& nt_header = nt_headers[i];
+        if (dos_header.e_magic != IMAGE_DOS_SIGNATURE || dos_header.e_lfanew < 0 || dos_header.e_lfanew + sizeof(nt_header) > requests[i].size)
+            continue;
+
+        // only images of the same bitness as this build, the headers are read into the native structs
+        std::memcpy(&nt_header, bytes + dos_header.e_lfanew, sizeof(nt_header));
+        if (nt_header.Signature != IMAGE_NT_SIGNATURE || nt_header.OptionalHeader.Magic != IMAGE_NT_OPTIONAL_HDR_MAGIC)
+            continue;
+
+        auto& table           = tables[i];
+        table.resize(nt_header.FileHeader.NumberOfSections);
+        const auto offset     = dos_header.e_lfanew + offsetof(IMAGE_NT_HEADERS, OptionalHeader) + nt_header.FileHeader.SizeOfOptionalHeader;
+        const auto table_size = table.size() * sizeof(IMAGE_SECTION_HEADER);
+
+        if (offset + table_size <= requests[i].size)
+            std::memcpy(table.data(), bytes + offset, table_size);
+        else
+        {
+            table_requests.push_back({ modules[i].base + offset, table.data(), table_size });
+            owners.push_back(i);
+        }
+
+        parsed[i] = true;
+    }
+
+    if (!table_requests.empty())
+    {
+        read_many(table_requests);
+        for (std::size_t i = 0; i < table_requests.size(); i++)
+        {
+            if (!table_requests[i].success)
+                parsed[owners[i]] = false;
+        }
+    }
+
+    for (std::size_t i = 0; i < modules.size(); i++)
+    {
+        if (!parsed[i])
+            continue;
+
+        const auto& nt_header = nt_headers[i];
+        auto& module          = modules[i];
+
+        // the image is mapped at its base as one allocation, SizeOfImage covers the reserved gaps the mappings leave out
+        module.size     = nt_header.OptionalHeader.SizeOfImage;
+        module.program  = (nt_header.FileHeader.Characteristics & IMAGE_FILE_DLL) == 0;
+        module.identity = { (static_cast<std::uint64_t>(nt_header.FileHeader.TimeDateStamp) << 32) | nt_header.OptionalHeader.CheckSum, module.size };
+
+        for (const auto& section : tables[i])
+        {
+            const auto is_executable = (section.Characteristics & IMAGE_SCN_MEM_EXECUTE) != 0;
+
+            if (const auto is_readable = (section.Characteristics & IMAGE_SCN_MEM_READ) != 0; is_executable && is_readable)
+                module.code.push_back({ module.base + section.VirtualAddress, std::min(section.SizeOfRawData, section.Misc.VirtualSize) });
+        }
+    }
+
+    return parsed;
+}
@@ -0,0 +1,20 @@
+#include <gensokyo.hpp>
+
+// there's no remote equivalent, GetWriteWatch only works on MEM_WRITE_WATCH allocations of the calling process
+gensokyo::impl::SoftDirty::SoftDirty([[maybe_unused]] std::uint32_t pid)
+{
+}
+
+void gensokyo::impl::SoftDirty::close() noexcept
+{
+}
+
+bool gensokyo::impl::SoftDirty::clear()
+{
+    return false;
+}
+
+bool gensokyo::impl::SoftDirty::written([[maybe_unused]] const MemoryRegion& region, [[maybe_unused]] std::vector<MemoryRegion>& ranges)
+{
+    return false;
+}
@@ -1,5 +1,7 @@
 #include <gensokyo.hpp>
 #include <tlhelp32.h>
+#include <psapi.h>
+#include <array>
 
 gensokyo::WinProcess::WinProcess(std::string_view name, AttachType type)
 {
@@ -41,6 +43,52 @@ bool gensokyo::WinProcess::write_impl(const std::uintptr_t address, void* buffer
     return written_bytes == size;
 }
 
+void gensokyo::WinProcess::for_each_mapping(HANDLE handle, const RegionCallbackFn& func)
+{
+    impl::Region region {};
+    MEMORY_BASIC_INFORMATION info {};
+    std::array<char, MAX_PATH> path {};
+
+    std::uintptr_t address {};
+    while (VirtualQueryEx(handle, reinterpret_cast<void*>(address), &info, sizeof(info)) == sizeof(info))
+    {
+        const auto base = reinterpret_cast<std::uintptr_t>(info.BaseAddress);
+        const auto next = base + info.RegionSize;
+
+        // reserved and free ranges have nothing to read
+        if (info.State == MEM_COMMIT)
+        {
+            // the low byte is the protection, the rest are modifiers like PAGE_GUARD
+            const auto protect = info.Protect & 0xFF;
+
+            region.address    = base;
+            region.size       = info.RegionSize;
+            region.readable   = !(info.Protect & PAGE_GUARD) && (protect & (PAGE_READONLY | PAGE_READWRITE | PAGE_WRITECOPY | PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY));
+            region.writable   = protect & (PAGE_READWRITE | PAGE_WRITECOPY | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY);
+            region.executable = protect & (PAGE_EXECUTE | PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY);
+            region.image      = info.Type == MEM_IMAGE;
+            region.offset     = base - reinterpret_cast<std::uintptr_t>(info.AllocationBase);
+
+            // private memory has no name so don't ask for it, names are NT paths like \Device\HarddiskVolume3\Windows\...
+            const auto length = info.Type == MEM_PRIVATE ? 0 : GetMappedFileNameA(handle, info.BaseAddress, path.data(), static_cast<DWORD>(path.size()));
+            region.path.assign(path.data(), length);
+
+            if (func(region))
+                return;
+        }
+
+        if (next <= address)
+            return;
+
+        address = next;
+    }
+}
+
+void gensokyo::WinProcess::enumerate_regions(const RegionCallbackFn& func)
+{
+    for_each_mapping(_handle, func);
+}
+
 bool gensokyo::WinProcess::attached()
 {
     return _pid != 0 && _handle != nullptr;
@@ -57,7 +105,7 @@ bool gensokyo::WinProcess::attach_by_process_name(std::string_view process_name)
     {
         if (process_name == entry.szExeFile)
         {
-            const auto handle = OpenProcess(PROCESS_VM_OPERATION | PROCESS_VM_READ | PROCESS_VM_WRITE, false, entry.th32ProcessID);
+            const auto handle = OpenProcess(PROCESS_QUERY_INFORMATION | PROCESS_VM_OPERATION | PROCESS_VM_READ | PROCESS_VM_WRITE, false, entry.th32ProcessID);
             [[unlikely]] if (!handle)
             {
                 CloseHandle(snapshot);
@@ -82,7 +130,7 @@ bool gensokyo::WinProcess::attach_by_window_name(std::string_view window_name, s
         return false;
 
     GetWindowThreadProcessId(hwnd, reinterpret_cast<LPDWORD>(&_pid));
-    _handle = OpenProcess(PROCESS_VM_OPERATION | PROCESS_VM_READ | PROCESS_VM_WRITE, false, _pid);
+    _handle = OpenProcess(PROCESS_QUERY_INFORMATION | PROCESS_VM_OPERATION | PROCESS_VM_READ | PROCESS_VM_WRITE, false, _pid);
 
     if (!_handle)
     {
@@ -0,0 +1,36 @@
+#include <gensokyo.hpp>
+
+#include <cstring>
+
+gensokyo::WriteQueue::WriteQueue(impl::Process& process)
+ : _process(process)
+{
+}
+
+void gensokyo::WriteQueue::write(std::uintptr_t address, const void* buffer, std::size_t size)
+{
+    const auto offset = _data.size();
+    _data.resize(offset + size);
+    std::memcpy(_data.data() + offset, buffer, size);
+
+    _entries.push_back({ address, offset, size });
+}
+
+std::size_t gensokyo::WriteQueue::flush()
+{
+    // _data doesn't move anymore, so the buffers can point into it
+    _requests.clear();
+    for (const auto& entry : _entries)
+        _requests.push_back({ entry.address, _data.data() + entry.offset, entry.size });
+
+    const auto count = _process.write_many(_requests);
+    clear();
+    return count;
+}
+
+void gensokyo::WriteQueue::clear()
+{
+    // the capacity stays for the next round
+    _data.clear();
+    _entries.clear();
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <gensokyo.hpp>
+#include <atomic>
+#include <cstring>
+#include <span>
+#include <vector>
+#if defined(WINDOWS)
+    #include <Windows.h>
+#else
+    #include <link.h>
+#endif
+
+namespace
+{
+    // just enough of a header at the start of image for Process::modules() to take it as a module of that size
+    inline void write_image_header(void* image, std::size_t size)
+    {
+#if defined(WINDOWS)
+        IMAGE_DOS_HEADER dos_header {};
+        dos_header.e_magic  = IMAGE_DOS_SIGNATURE;
+        dos_header.e_lfanew = sizeof(dos_header);
+
+        IMAGE_NT_HEADERS nt_header {};
+        nt_header.Signature                       = IMAGE_NT_SIGNATURE;
+        nt_header.FileHeader.Characteristics      = IMAGE_FILE_DLL;
+        nt_header.FileHeader.SizeOfOptionalHeader = sizeof(nt_header.OptionalHeader);
+        nt_header.OptionalHeader.Magic            = IMAGE_NT_OPTIONAL_HDR_MAGIC;
+        nt_header.OptionalHeader.SizeOfImage      = static_cast<DWORD>(size);
+
+        std::memcpy(image, &dos_header, sizeof(dos_header));
+        std::memcpy(static_cast<std::uint8_t*>(image) + sizeof(dos_header), &nt_header, sizeof(nt_header));
+#else
+        ElfW(Ehdr) header {};
+        std::memcpy(header.e_ident, ELFMAG, SELFMAG);
+        header.e_ident[EI_CLASS] = sizeof(void*) == 8 ? ELFCLASS64 : ELFCLASS32;
+        header.e_phoff           = sizeof(header);
+        header.e_phentsize       = sizeof(ElfW(Phdr));
+        header.e_phnum           = 1;
+
+        ElfW(Phdr) segment {};
+        segment.p_type  = PT_LOAD;
+        segment.p_flags = PF_R | PF_W;
+        segment.p_memsz = size;
+
+        std::memcpy(image, &header, sizeof(header));
+        std::memcpy(static_cast<std::uint8_t*>(image) + sizeof(header), &segment, sizeof(segment));
+#endif
+    }
+
+    // reads from this process at address + offset, reads that touch a bad range fail
+    class BufferProcess : public gensokyo::impl::Process
+    {
+      public:
+        std::uintptr_t bad_begin {};
+        std::uintptr_t bad_end {};
+        std::atomic<std::size_t> reads {};
+        std::atomic<std::size_t> batches {};
+        std::atomic<std::size_t> writes {};
+        std::vector<gensokyo::impl::Region> mappings {};
+
+      protected:
+        void enumerate_regions(const RegionCallbackFn& func) override
+        {
+            for (const auto& region : mappings)
+            {
+                if (func(region))
+                    return;
+            }
+        }
+
+        bool read_impl(std::uintptr_t address, void* buffer, std::size_t size) override
+        {
+            reads++;
+            if (address < bad_end && address + size > bad_begin)
+                return false;
+
+            std::memcpy(buffer, reinterpret_cast<const void*>(address), size);
+            return true;
+        }
+
+        void read_many_impl(std::span<gensokyo::impl::ReadRequest> requests) override
+        {
+            batches++;
+            Process::read_many_impl(requests);
+        }
+
+        bool write_impl(std::uintptr_t address, void* buffer, std::size_t size) override
+        {
+            writes++;
+            if (address < bad_end && address + size > bad_begin)
+                return false;
+
+            std::memcpy(reinterpret_cast<void*>(address), buffer, size);
+            return true;
+        }
+    };
+}
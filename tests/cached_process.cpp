@@ -0,0 +1,132 @@
+#include <gensokyo.hpp>
+#include <catch2/catch_all.hpp>
+#include "buffer_process.hpp"
+#include <array>
+#include <chrono>
+#include <thread>
+
+TEST_CASE("CachedProcess", "Process")
+{
+    // page aligned so the page count below is exact
+    alignas(0x1000) static std::array<std::uint8_t, 0x4000> memory {};
+    for (std::size_t i = 0; i < memory.size(); i++)
+        memory[i] = static_cast<std::uint8_t>(i * 3);
+
+    const auto base = reinterpret_cast<std::uintptr_t>(memory.data());
+
+    BufferProcess process {};
+    gensokyo::CachedProcess cached(process);
+
+    SECTION("HitsAndInvalidate")
+    {
+        REQUIRE(cached.read<std::uint32_t>(base + 0x10) == *reinterpret_cast<std::uint32_t*>(memory.data() + 0x10));
+        REQUIRE(cached.read<std::uint32_t>(base + 0x20) == *reinterpret_cast<std::uint32_t*>(memory.data() + 0x20));
+        REQUIRE(cached.read<std::uint8_t>(base + 0xFFF) == memory[0xFFF]);
+
+        // one page fetched, then served from memory
+        REQUIRE(process.reads == 1);
+        REQUIRE(cached.stats().hits == 2);
+        REQUIRE(cached.stats().misses == 1);
+
+        memory[0x10] = 0xAB;
+        REQUIRE(cached.read<std::uint8_t>(base + 0x10) != 0xAB);
+
+        cached.invalidate();
+        REQUIRE(cached.read<std::uint8_t>(base + 0x10) == 0xAB);
+        REQUIRE(process.reads == 2);
+    }
+
+    SECTION("AcrossPages")
+    {
+        std::array<std::uint8_t, 0x1010> buffer {};
+        REQUIRE(cached.read(base + 0xFF8, buffer.data(), buffer.size()));
+        REQUIRE(std::equal(buffer.begin(), buffer.end(), memory.begin() + 0xFF8));
+        REQUIRE(cached.stats().misses == 3);
+
+        REQUIRE(cached.read(base + 0xFF8, buffer.data(), buffer.size()));
+        REQUIRE(cached.stats().hits == 3);
+        REQUIRE(process.reads == 3);
+    }
+
+    SECTION("WriteThrough")
+    {
+        REQUIRE(cached.read<std::uint32_t>(base + 0x1000));
+        REQUIRE(cached.write<std::uint32_t>(base + 0x1FFE, 0xDEADBEEF));
+
+        // the memory and the cached page both have the new value
+        REQUIRE(*reinterpret_cast<std::uint32_t*>(memory.data() + 0x1FFE) == 0xDEADBEEF);
+        REQUIRE(cached.read<std::uint16_t>(base + 0x1FFE) == 0xBEEF);
+        REQUIRE(process.reads == 1);
+    }
+
+    SECTION("MaxAge")
+    {
+        gensokyo::CachedProcess aging(process, std::chrono::milliseconds(20));
+        REQUIRE(aging.read<std::uint8_t>(base));
+        REQUIRE(aging.read<std::uint8_t>(base));
+        REQUIRE(process.reads == 1);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(40));
+        REQUIRE(aging.read<std::uint8_t>(base));
+        REQUIRE(process.reads == 2);
+    }
+
+    SECTION("ReadMany")
+    {
+        std::array<std::uint32_t, 4> values {};
+        std::vector<gensokyo::impl::ReadRequest> requests { { base + 0x10, &values[0], 4 }, { base + 0x2010, &values[1], 4 }, { base + 0x20, &values[2], 4 }, { base + 0x3000, &values[3], 4 } };
+
+        REQUIRE(cached.read_many(requests) == 4);
+        REQUIRE(values[1] == *reinterpret_cast<std::uint32_t*>(memory.data() + 0x2010));
+        REQUIRE(cached.stats().misses == 4);
+
+        // the three pages were fetched with one read_many, which merges nothing this far apart
+        const auto reads = process.reads.load();
+        REQUIRE(cached.read_many(requests) == 4);
+        REQUIRE(process.reads == reads);
+        REQUIRE(cached.stats().hits == 4);
+    }
+
+    SECTION("LeastRecentlyUsed")
+    {
+        gensokyo::CachedProcess small(process, {}, 2);
+        REQUIRE(small.read<std::uint8_t>(base) == memory[0]);
+        REQUIRE(small.read<std::uint8_t>(base + 0x1000) == memory[0x1000]);
+        REQUIRE(small.read<std::uint8_t>(base) == memory[0]);
+
+        // the second page was used least recently, so it makes room for the third
+        REQUIRE(small.read<std::uint8_t>(base + 0x2000) == memory[0x2000]);
+        REQUIRE(small.read<std::uint8_t>(base) == memory[0]);
+        REQUIRE(process.reads == 3);
+
+        REQUIRE(small.read<std::uint8_t>(base + 0x1000) == memory[0x1000]);
+        REQUIRE(process.reads == 4);
+    }
+
+    SECTION("ReadManyBiggerThanTheCache")
+    {
+        gensokyo::CachedProcess small(process, {}, 2);
+
+        std::array<std::uint32_t, 4> values {};
+        std::vector<gensokyo::impl::ReadRequest> requests {};
+        for (std::size_t i = 0; i < values.size(); i++)
+            requests.push_back({ base + i * 0x1000 + 0x10, &values[i], sizeof(std::uint32_t) });
+
+        // the pages evict each other, the requests are still served from the one batch
+        REQUIRE(small.read_many(requests) == values.size());
+        REQUIRE(process.reads == 1);
+
+        for (std::size_t i = 0; i < values.size(); i++)
+            REQUIRE(values[i] == *reinterpret_cast<std::uint32_t*>(memory.data() + i * 0x1000 + 0x10));
+    }
+
+    SECTION("PartlyMapped")
+    {
+        // a page that can't be read whole still serves the bytes that can be read, uncached
+        process.bad_begin = base + 0x1800;
+        process.bad_end   = base + 0x1801;
+
+        REQUIRE(cached.read<std::uint32_t>(base + 0x1000) == *reinterpret_cast<std::uint32_t*>(memory.data() + 0x1000));
+        REQUIRE(!cached.read<std::uint32_t>(base + 0x1800));
+    }
+}
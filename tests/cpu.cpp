@@ -5,7 +5,8 @@
 std::unordered_map<int, std::string> arch_name = {
     {0, "None"},
     {1, "SSE2"},
-    {2, "AVX2"}
+    {2, "AVX2"},
+    {3, "AVX512"}
 };
 
 int main()
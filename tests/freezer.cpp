@@ -0,0 +1,60 @@
+#include <gensokyo.hpp>
+#include <catch2/catch_all.hpp>
+#include "buffer_process.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+TEST_CASE("Freezer", "Process")
+{
+    static std::array<std::uint32_t, 0x10> values {};
+    values = {};
+
+    BufferProcess process {};
+    gensokyo::Freezer freezer(process, std::chrono::milliseconds(1));
+
+    const auto health = freezer.freeze<std::uint32_t>(reinterpret_cast<std::uintptr_t>(&values[0]), 100);
+    freezer.freeze<std::uint32_t>(reinterpret_cast<std::uintptr_t>(&values[1]), 200);
+    freezer.freeze<std::uint32_t>(reinterpret_cast<std::uintptr_t>(&values[8]), 300);
+    REQUIRE(freezer.size() == 3);
+
+    const auto wait_for = [&](std::size_t index, std::uint32_t value)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (std::atomic_ref(values[index]).load() != value && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        return std::atomic_ref(values[index]).load() == value;
+    };
+
+    REQUIRE(wait_for(0, 100));
+    std::atomic_ref(values[0]).store(1);
+    REQUIRE(wait_for(0, 100));
+
+    // the same address again replaces the old value
+    freezer.freeze<std::uint32_t>(reinterpret_cast<std::uintptr_t>(&values[8]), 301);
+    REQUIRE(freezer.size() == 3);
+    REQUIRE(wait_for(8, 301));
+
+    REQUIRE(freezer.unfreeze(health));
+    REQUIRE_FALSE(freezer.unfreeze(health));
+
+    // the new interval starts with a round right away, after that the thread sleeps
+    const auto rounds = freezer.rounds();
+    freezer.set_interval(std::chrono::hours(1));
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (freezer.rounds() == rounds && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    REQUIRE(freezer.rounds() == rounds + 1);
+
+    std::atomic_ref(values[0]).store(1);
+    values[1] = 0;
+    values[8] = 0;
+
+    const auto writes = process.writes.load();
+    REQUIRE(freezer.apply() == 2);
+    REQUIRE(process.writes == writes + 2);
+    REQUIRE((values[0] == 1 && values[1] == 200 && values[8] == 301));
+}
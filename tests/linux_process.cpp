@@ -0,0 +1,233 @@
+#include <gensokyo.hpp>
+#include <algorithm>
+#include <csignal>
+#include <cstring>
+#include <filesystem>
+#include <link.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace
+{
+    // a forked child has the same layout, so the addresses of these are valid in it too
+    volatile std::uint32_t value = 0x1337;
+    std::uint8_t signature[] = { 0x48, 0x8B, 0x05, 0x11, 0x22, 0x33, 0x44, 0xC3 };
+
+    bool test(gensokyo::LinuxProcess& process)
+    {
+        if (!process.attached())
+        {
+            gensokyo::logger.error("Failed to attach");
+            return false;
+        }
+
+        gensokyo::logger.success("process attached, method:{}", static_cast<int>(process.access_method()));
+
+        const auto address = reinterpret_cast<std::uintptr_t>(&value);
+        if (process.read<std::uint32_t>(address) != 0x1337)
+        {
+            gensokyo::logger.error("Failed to read");
+            return false;
+        }
+
+        if (!process.write<std::uint32_t>(address, 0xC0FFEE) || process.read<std::uint32_t>(address) != 0xC0FFEE)
+        {
+            gensokyo::logger.error("Failed to write");
+            return false;
+        }
+
+        auto pattern    = gensokyo::pattern::Type("48 8B 05 ? ? ? ? C3");
+        const auto base = reinterpret_cast<std::uintptr_t>(signature) & ~std::uintptr_t(0xFFF);
+        if (process.find({ base, reinterpret_cast<std::uintptr_t>(signature) - base + sizeof(signature) }, pattern, 0x100).ptr != reinterpret_cast<std::uintptr_t>(signature))
+        {
+            gensokyo::logger.error("Failed to find");
+            return false;
+        }
+
+        // the unmapped page in the middle fails on its own, the reads after it still succeed
+        std::uint32_t values[3] {};
+        std::uint8_t bytes[sizeof(signature)] {};
+        gensokyo::impl::ReadRequest requests[] = { { address, &values[0], sizeof(std::uint32_t) },
+                                                   { 0x1000, &values[1], sizeof(std::uint32_t) },
+                                                   { reinterpret_cast<std::uintptr_t>(signature), bytes, sizeof(bytes) },
+                                                   { address, &values[2], sizeof(std::uint32_t) } };
+
+        if (process.read_many(requests) != 3 || requests[1].success || values[0] != 0xC0FFEE || values[2] != 0xC0FFEE || std::memcmp(bytes, signature, sizeof(bytes)) != 0)
+        {
+            gensokyo::logger.error("Failed to read_many");
+            return false;
+        }
+
+        // the same for writes, the later of two writes to the same bytes wins
+        const std::uint32_t first  = 0x1111;
+        const std::uint32_t second = 0x2222;
+        gensokyo::impl::WriteRequest writes[] = { { address, &first, sizeof(first) }, { 0x1000, &first, sizeof(first) }, { address, &second, sizeof(second) } };
+
+        if (process.write_many(writes) != 2 || writes[1].success || process.read<std::uint32_t>(address) != 0x2222)
+        {
+            gensokyo::logger.error("Failed to write_many");
+            return false;
+        }
+
+        // code isn't writable, the write has to be forced like a debugger does
+        const auto code_address = reinterpret_cast<std::uintptr_t>(&test);
+        const auto original     = process.read<std::uint32_t>(code_address).value_or(0);
+        if (!process.write<std::uint32_t>(code_address, ~original) || process.read<std::uint32_t>(code_address) != ~original ||
+            !process.write<std::uint32_t>(code_address, original))
+        {
+            gensokyo::logger.error("Failed to write to code");
+            return false;
+        }
+
+        // the code of this function is in an executable mapping of the test binary
+        const auto code    = reinterpret_cast<std::uintptr_t>(&test);
+        const auto regions = process.regions({ .readable = true, .executable = true, .image = true });
+        const auto region  = std::ranges::find_if(regions,
+                                                 [&](const gensokyo::impl::Region& entry)
+                                                 {
+                                                     return code >= entry.address && code < entry.address + entry.size;
+                                                 });
+
+        const auto writable = std::ranges::any_of(regions, &gensokyo::impl::Region::writable);
+        if (region == regions.end() || !std::filesystem::equivalent(region->path, "/proc/self/exe") || writable)
+        {
+            gensokyo::logger.error("Failed to list regions");
+            return false;
+        }
+
+        // soft-dirty tracking when the kernel has it, full compares when it doesn't
+        gensokyo::MemoryWatch watch(process, true);
+        if (!watch.add({ address & ~std::uintptr_t { 0xFFF }, 0x1000 }) || !process.write<std::uint32_t>(address, 0xBEEF))
+        {
+            gensokyo::logger.error("Failed to watch");
+            return false;
+        }
+
+        const auto changes = watch.poll();
+        if (changes.empty() || changes.front().address < address || changes.back().address + changes.back().size > address + sizeof(std::uint32_t))
+        {
+            gensokyo::logger.error("Failed to see the change, soft-dirty:{}", watch.uses_soft_dirty());
+            return false;
+        }
+
+        return true;
+    }
+
+    // what the loader of this process has, the child has the same
+    struct LoadedModule
+    {
+        std::string name {};
+        std::uintptr_t base {};
+        std::size_t size {};
+        std::vector<gensokyo::impl::MemoryRegion> code {};
+    };
+
+    std::vector<LoadedModule> loaded_modules()
+    {
+        std::vector<LoadedModule> modules {};
+        dl_iterate_phdr(
+          [](dl_phdr_info* info, std::size_t, void* user) -> int
+          {
+              // the vdso isn't a file
+              const auto name = std::string_view(info->dlpi_name ? info->dlpi_name : "");
+              if (!name.empty() && !name.starts_with('/'))
+                  return 0;
+
+              LoadedModule module { std::filesystem::path(name).filename().string() };
+              std::uintptr_t lowest  = UINTPTR_MAX;
+              std::uintptr_t highest = 0;
+              for (auto i = 0; i < info->dlpi_phnum; i++)
+              {
+                  const auto& header = info->dlpi_phdr[i];
+                  if (header.p_type != PT_LOAD)
+                      continue;
+
+                  lowest  = std::min<std::uintptr_t>(lowest, header.p_vaddr);
+                  highest = std::max<std::uintptr_t>(highest, header.p_vaddr + header.p_memsz);
+
+                  if ((header.p_flags & PF_R) && (header.p_flags & PF_X))
+                      module.code.push_back({ info->dlpi_addr + header.p_vaddr, std::min(header.p_filesz, header.p_memsz) });
+              }
+
+              module.base = info->dlpi_addr + lowest;
+              module.size = highest - lowest;
+              static_cast<std::vector<LoadedModule>*>(user)->push_back(std::move(module));
+              return 0;
+          },
+          &modules);
+
+        return modules;
+    }
+
+    bool test_modules(gensokyo::LinuxProcess& process)
+    {
+        const auto modules = process.modules();
+        for (const auto& loaded : loaded_modules())
+        {
+            const auto module = std::ranges::find(modules, loaded.base, &gensokyo::impl::ModuleInfo::base);
+            if (module == modules.end() || module->size != loaded.size || module->program != loaded.name.empty())
+            {
+                gensokyo::logger.error("Failed to list module {}", loaded.name);
+                return false;
+            }
+
+            const auto same_code = std::ranges::equal(module->code, loaded.code,
+                                                      [](const gensokyo::impl::MemoryRegion& left, const gensokyo::impl::MemoryRegion& right)
+                                                      {
+                                                          return left.address == right.address && left.size == right.size;
+                                                      });
+
+            const auto identity = gensokyo::impl::Module(loaded.name).identity();
+            if (!same_code || module->identity.build != identity.build || module->identity.size != identity.size)
+            {
+                gensokyo::logger.error("Failed to read the headers of {}", module->name);
+                return false;
+            }
+        }
+
+        // the child's libc is at the same place, so a remote copy finds the same bytes at the same addresses
+        const auto pattern = gensokyo::pattern::Type("48 8B 05 ? ? ? ? C3");
+        const gensokyo::impl::Module local("libc.so");
+        const gensokyo::impl::Module remote(process, "libc.so");
+        const auto found = remote.find(pattern);
+        if (found.ptr == 0 || found.ptr != local.find(pattern).ptr || remote.base() != local.base() || remote.size() != local.size())
+        {
+            gensokyo::logger.error("Failed to scan a module of the process");
+            return false;
+        }
+
+        return true;
+    }
+}
+
+int main()
+{
+    const auto child = fork();
+    if (child == 0)
+    {
+        while (true)
+            pause();
+    }
+
+    auto result = 0;
+
+    try
+    {
+        gensokyo::LinuxProcess process(static_cast<std::uint32_t>(child));
+        if (!test(process) || !test_modules(process))
+            result = 1;
+    }
+    catch (std::runtime_error& ex)
+    {
+        gensokyo::logger.error("Exception: {}", ex.what());
+        result = 1;
+    }
+
+    kill(child, SIGKILL);
+    waitpid(child, nullptr, 0);
+
+    if (result == 0)
+        gensokyo::logger.success("read, write, find, regions, watch and modules work");
+
+    return result;
+}
@@ -0,0 +1,61 @@
+#include <gensokyo.hpp>
+#include <catch2/catch_all.hpp>
+#include <array>
+#include <numeric>
+#include <vector>
+
+TEST_CASE("LocalProcess", "Process")
+{
+    static const char text[] = "read only";
+    std::vector<std::uint32_t> values(0x100);
+    std::iota(values.begin(), values.end(), 0);
+
+    gensokyo::LocalProcess process {};
+    REQUIRE(process.attached());
+
+    const auto at = [&](std::size_t index)
+    {
+        return reinterpret_cast<std::uintptr_t>(&values[index]);
+    };
+
+    REQUIRE(process.read<std::uint32_t>(at(0x42)) == 0x42);
+    REQUIRE(process.write<std::uint32_t>(at(0x42), 0x1337));
+    REQUIRE(values[0x42] == 0x1337);
+
+    const auto view = process.view(at(0), 0x10);
+    REQUIRE(view.data() == reinterpret_cast<const std::uint8_t*>(values.data()));
+    REQUIRE(view.size() == 0x10);
+
+    REQUIRE_FALSE(process.read<std::uint32_t>(0x10));
+    REQUIRE(process.view(0x10, 4).empty());
+    REQUIRE(process.view(~std::uintptr_t {} - 2, 4).empty());
+    REQUIRE_FALSE(process.write<char>(reinterpret_cast<std::uintptr_t>(text), 'R'));
+
+    SECTION("NewMapping")
+    {
+        // big enough to get its own mapping after the map was read
+        std::vector<std::uint8_t> mapped(0x400000, 0xCC);
+        REQUIRE(process.read<std::uint8_t>(reinterpret_cast<std::uintptr_t>(mapped.data()) + 0x3FFFFF) == 0xCC);
+    }
+
+    SECTION("ReadMany")
+    {
+        std::uint32_t first {};
+        std::uint32_t second {};
+        std::array<gensokyo::impl::ReadRequest, 3> requests { { { at(1), &first, sizeof(first) }, { 0x10, &second, sizeof(second) }, { at(0xFF), &second, sizeof(second) } } };
+
+        REQUIRE(process.read_many(requests) == 2);
+        REQUIRE_FALSE(requests[1].success);
+        REQUIRE((first == 1 && second == 0xFF));
+    }
+
+    SECTION("Regions")
+    {
+        const auto regions = process.regions({ .readable = true, .writable = true });
+        REQUIRE(std::ranges::any_of(regions,
+                                    [&](const gensokyo::impl::Region& region)
+                                    {
+                                        return at(0) >= region.address && at(0) < region.address + region.size;
+                                    }));
+    }
+}
@@ -0,0 +1,73 @@
+#include <gensokyo.hpp>
+#include <catch2/catch_all.hpp>
+#include "buffer_process.hpp"
+#include <utility>
+#include <vector>
+
+TEST_CASE("MemoryWatch", "Process")
+{
+    std::vector<std::uint8_t> buffer(0x3000);
+    for (std::size_t i = 0; i < buffer.size(); i++)
+        buffer[i] = static_cast<std::uint8_t>(i * 3);
+
+    const auto base = reinterpret_cast<std::uintptr_t>(buffer.data());
+
+    BufferProcess process {};
+    gensokyo::MemoryWatch watch(process, true);
+
+    // a buffer process has no pid to track, every region is compared in full
+    REQUIRE_FALSE(watch.uses_soft_dirty());
+
+    REQUIRE(watch.add({ base, 0x2000 }) == 0);
+    // the tail doesn't fill a whole register
+    REQUIRE(watch.add({ base + 0x2000, 0x1F }) == 1);
+    REQUIRE_FALSE(watch.add({ base, 0 }));
+
+    const auto to_offsets = [&](const std::vector<gensokyo::impl::MemoryRegion>& changes)
+    {
+        std::vector<std::pair<std::size_t, std::size_t>> values {};
+        for (const auto& change : changes)
+            values.emplace_back(change.address - base, change.size);
+
+        return values;
+    };
+
+    REQUIRE(watch.poll().empty());
+
+    // last byte of a 64 byte block, a run across blocks, first byte of the second region and its tail
+    buffer[0x3F] ^= 0xFF;
+    for (std::size_t i = 0x7C; i < 0xC4; i++)
+        buffer[i] ^= 0xFF;
+    buffer[0x1FFF] ^= 0xFF;
+    buffer[0x2000] ^= 0xFF;
+    buffer[0x201E] ^= 0xFF;
+    // outside of anything watched
+    buffer[0x2020] ^= 0xFF;
+
+    const std::vector<std::pair<std::size_t, std::size_t>> expected { { 0x3F, 1 }, { 0x7C, 0x48 }, { 0x1FFF, 2 }, { 0x201E, 1 } };
+    REQUIRE(to_offsets(watch.poll()) == expected);
+    REQUIRE(watch.snapshot(0)[0x80] == buffer[0x80]);
+    REQUIRE(watch.poll().empty());
+
+    SECTION("FailedRead")
+    {
+        buffer[0x10] ^= 0xFF;
+        process.bad_begin = base;
+        process.bad_end   = base + 1;
+
+        // the first region keeps its old content and reports the change once it can be read again
+        REQUIRE(watch.poll().empty());
+        REQUIRE(watch.snapshot(0)[0x10] != buffer[0x10]);
+
+        process.bad_end = base;
+        REQUIRE(to_offsets(watch.poll()) == std::vector<std::pair<std::size_t, std::size_t>> { { 0x10, 1 } });
+    }
+
+    SECTION("Clear")
+    {
+        watch.clear();
+        buffer[0x10] ^= 0xFF;
+        REQUIRE(watch.size() == 0);
+        REQUIRE(watch.poll().empty());
+    }
+}
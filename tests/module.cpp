@@ -0,0 +1,45 @@
+#include <gensokyo.hpp>
+#include <catch2/catch_all.hpp>
+#include <utility>
+#include <vector>
+
+TEST_CASE("Module", "FindPattern")
+{
+    // a few segments of different sizes, reported at addresses other than where the bytes are
+    std::vector<std::vector<std::uint8_t>> buffers { std::vector<std::uint8_t>(0x1000, 0xCC), std::vector<std::uint8_t>(3 * 1024 * 1024, 0xCC),
+                                                     std::vector<std::uint8_t>(0x200, 0xCC), std::vector<std::uint8_t>(1024 * 1024, 0xCC) };
+    const std::vector<std::uintptr_t> addresses { 0x10001000, 0x10100000, 0x10500000, 0x10600000 };
+
+    gensokyo::impl::Module module {};
+    for (std::size_t i = 0; i < buffers.size(); i++)
+        module.get_segments().emplace_back(addresses[i], buffers[i].data(), buffers[i].size());
+
+    auto pattern = gensokyo::pattern::Type("48 8B 05 ? ? ? ? C3");
+
+    REQUIRE(module.find(pattern).ptr == 0);
+    REQUIRE(module.find(gensokyo::pattern::parallel, pattern).ptr == 0);
+    REQUIRE(module.find_all(pattern).empty());
+    REQUIRE(module.find_all(gensokyo::pattern::parallel, pattern).empty());
+
+    const std::vector<std::pair<std::size_t, std::size_t>> offsets { { 1, 0x3FFFC }, { 1, 0x2FFFF8 }, { 2, 0x10 }, { 3, 0x0 }, { 3, 0xFFFF8 } };
+    std::vector<std::uintptr_t> expected {};
+    for (const auto& [segment, offset] : offsets)
+    {
+        std::ranges::copy(std::initializer_list<std::uint8_t> { 0x48, 0x8B, 0x05, 0x11, 0x22, 0x33, 0x44, 0xC3 }, buffers[segment].begin() + offset);
+        expected.push_back(addresses[segment] + offset);
+    }
+
+    const auto to_addresses = [](const std::vector<gensokyo::Address>& results)
+    {
+        std::vector<std::uintptr_t> values {};
+        for (const auto result : results)
+            values.push_back(result.ptr);
+
+        return values;
+    };
+
+    REQUIRE(module.find(pattern).ptr == expected.front());
+    REQUIRE(module.find(gensokyo::pattern::parallel, pattern).ptr == expected.front());
+    REQUIRE(to_addresses(module.find_all(pattern)) == expected);
+    REQUIRE(to_addresses(module.find_all(gensokyo::pattern::parallel, pattern)) == expected);
+}
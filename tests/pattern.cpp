@@ -81,7 +81,7 @@ TEST_CASE("NoWildcard", "MakePattern")
     SECTION("Compiletime")
     {
         auto pattern_compile_time = GENSOKYO_MAKE_PATTERN("00 11 22 33 44 55 66 77 88 99 AA BB CC DD EE FF");
-        REQUIRE(type_name<decltype(pattern_compile_time)>() == "std::array<std::optional<unsigned char>, 16>");
+        REQUIRE(type_name<decltype(pattern_compile_time)>() == "std::array<gensokyo::pattern::impl::HexData, 16>");
         REQUIRE(pattern_compile_time.size() == 16);
         REQUIRE(pattern_compile_time[0] == 0x00);
         REQUIRE(pattern_compile_time[1] == 0x11);
@@ -129,7 +129,7 @@ TEST_CASE("FullWildcard", "MakePattern")
     SECTION("Compiletime")
     {
         auto pattern_compile_time = GENSOKYO_MAKE_PATTERN("00 ? 22 ?? 44 ? 66 ?? 88 ? AA ?? CC ? EE ??");
-        REQUIRE(type_name<decltype(pattern_compile_time)>() == "std::array<std::optional<unsigned char>, 16>");
+        REQUIRE(type_name<decltype(pattern_compile_time)>() == "std::array<gensokyo::pattern::impl::HexData, 16>");
         REQUIRE(pattern_compile_time.size() == 16);
         REQUIRE(pattern_compile_time[0] == 0x00);
         REQUIRE(pattern_compile_time[1].has_value() == false);
@@ -157,17 +157,17 @@ TEST_CASE("OneWildcard", "MakePattern")
     REQUIRE(type_name<decltype(pattern)>() == "gensokyo::pattern::impl::Pattern<>");
     REQUIRE(pattern.size() == 3);
     REQUIRE(pattern[0] == 0x00);
-    REQUIRE(pattern[1].has_value() == false);
-    REQUIRE(pattern[2].has_value() == false);
+    REQUIRE(pattern[1] == gensokyo::pattern::impl::HexData(0x01, 0x0F));
+    REQUIRE(pattern[2] == gensokyo::pattern::impl::HexData(0x20, 0xF0));
 
     SECTION("Compiletime")
     {
         auto pattern_compile_time = GENSOKYO_MAKE_PATTERN("00 ?1 2?");
-        REQUIRE(type_name<decltype(pattern_compile_time)>() == "std::array<std::optional<unsigned char>, 3>");
+        REQUIRE(type_name<decltype(pattern_compile_time)>() == "std::array<gensokyo::pattern::impl::HexData, 3>");
         REQUIRE(pattern_compile_time.size() == 3);
         REQUIRE(pattern_compile_time[0] == 0x00);
-        REQUIRE(pattern_compile_time[1].has_value() == false);
-        REQUIRE(pattern_compile_time[2].has_value() == false);
+        REQUIRE(pattern_compile_time[1] == gensokyo::pattern::impl::HexData(0x01, 0x0F));
+        REQUIRE(pattern_compile_time[2] == gensokyo::pattern::impl::HexData(0x20, 0xF0));
     }
 }
 
@@ -217,6 +217,344 @@ TEST_CASE("Different wildcard", "MakePattern")
     REQUIRE(pattern[15].has_value() == false);
 }
 
+TEST_CASE("Storage", "MakePattern")
+{
+    // fits the inline storage
+    auto pattern = gensokyo::pattern::Type("48 8B ? 89");
+    REQUIRE(pattern.size() == 4);
+    REQUIRE(gensokyo::pattern::impl::PatternView(pattern).data() == pattern.bytes.data());
+
+    // spills to the heap once it's longer than the inline storage
+    std::string text {};
+    for (std::size_t i = 0; i < gensokyo::pattern::impl::PatternBytes::inline_capacity + 8; i++)
+        text += i % 2 ? "? " : fmt::format("{:02X} ", i);
+    text.pop_back();
+
+    auto long_pattern = gensokyo::pattern::Type(text);
+    REQUIRE(long_pattern.size() == gensokyo::pattern::impl::PatternBytes::inline_capacity + 8);
+    REQUIRE(long_pattern[70] == 70);
+    REQUIRE(long_pattern[71].has_value() == false);
+
+    // copies don't share storage
+    auto copy = long_pattern;
+    REQUIRE(copy.bytes.data() != long_pattern.bytes.data());
+    REQUIRE(std::ranges::equal(copy.bytes, long_pattern.bytes));
+}
+
+TEST_CASE("FindMany", "FindPattern")
+{
+    std::vector<std::uint8_t> buffer(0x1000, 0xCC);
+    auto write = [&](std::size_t offset, std::initializer_list<std::uint8_t> bytes)
+    {
+        std::ranges::copy(bytes, buffer.begin() + offset);
+    };
+
+    write(0x100, { 0x55, 0x8B, 0xEC, 0x83, 0xEC });
+    write(0x500, { 0x55, 0x8B, 0xEC, 0x51, 0x10 });
+    write(0x800, { 0xE8, 0x01, 0x02, 0x03, 0x04, 0x90 });
+    write(0x900, { 0x55, 0x8B, 0xEC, 0x83, 0xEC });
+    write(0xFFD, { 0x48, 0x8B, 0x05 });
+
+    std::vector<gensokyo::pattern::Type> patterns {
+        gensokyo::pattern::Type("55 8B EC 83 EC"),
+        gensokyo::pattern::Type("55 8B EC ? 10"),
+        gensokyo::pattern::Type("E8 ? ? ? ? 90"),
+        gensokyo::pattern::Type("DE AD BE EF"),
+        gensokyo::pattern::Type("48 8B 05"),
+    };
+
+    const auto base = reinterpret_cast<std::uintptr_t>(buffer.data());
+
+    auto check = [&](const std::vector<gensokyo::Address>& results)
+    {
+        REQUIRE(results.size() == patterns.size());
+        REQUIRE(results[0].ptr == base + 0x100);
+        REQUIRE(results[1].ptr == base + 0x500);
+        REQUIRE(results[2].ptr == base + 0x800);
+        REQUIRE(results[3].ptr == 0);
+        REQUIRE(results[4].ptr == base + 0xFFD);
+    };
+
+    SECTION("std")
+    {
+        check(gensokyo::pattern::impl::find_many_std(buffer.data(), buffer.size(), patterns));
+    }
+
+    SECTION("SIMD_SSE")
+    {
+        check(gensokyo::pattern::impl::find_many_simd<gensokyo::simd::iSSE>(buffer.data(), buffer.size(), patterns));
+    }
+
+    SECTION("SIMD_AVX2")
+    {
+        check(gensokyo::pattern::impl::find_many_simd<gensokyo::simd::iAVX2>(buffer.data(), buffer.size(), patterns));
+    }
+
+#if defined(GENSOKYO_SIMD_AVX512)
+    SECTION("SIMD_AVX512")
+    {
+        if (gensokyo::cpu.get_arch() == gensokyo::CPUArch::AVX512)
+            check(gensokyo::pattern::impl::find_many_simd<gensokyo::simd::iAVX512>(buffer.data(), buffer.size(), patterns));
+    }
+#endif
+
+    SECTION("Hybrid")
+    {
+        check(gensokyo::pattern::find_many(buffer, patterns));
+    }
+}
+
+TEST_CASE("FindAll", "FindPattern")
+{
+    std::vector<std::uint8_t> buffer(0x1000, 0xCC);
+    const std::vector<std::size_t> offsets { 0x0, 0x40, 0x45, 0x7F0, 0xFFB };
+    for (const auto offset : offsets)
+        std::ranges::copy(std::initializer_list<std::uint8_t> { 0xE8, 0x10, 0x20, 0x30, 0x40 }, buffer.begin() + offset);
+
+    const auto base = reinterpret_cast<std::uintptr_t>(buffer.data());
+
+    auto pattern = gensokyo::pattern::Type("E8 ? ? ? 40");
+    std::vector<std::uintptr_t> results {};
+    for (const auto address : gensokyo::pattern::find_all(buffer, pattern))
+        results.push_back(address.ptr - base);
+
+    REQUIRE(results == std::vector<std::uintptr_t>(offsets.begin(), offsets.end()));
+
+    auto missing = gensokyo::pattern::Type("E8 ? ? ? 41");
+    auto no_matches = gensokyo::pattern::find_all(buffer, missing);
+    REQUIRE(no_matches.begin() == no_matches.end());
+}
+
+TEST_CASE("LeadingWildcard", "FindPattern")
+{
+    std::vector<std::uint8_t> buffer(0x1000, 0xCC);
+    std::ranges::copy(std::initializer_list<std::uint8_t> { 0x48, 0x89, 0x5C, 0x24, 0x08, 0x57 }, buffer.begin() + 0x800);
+    const auto base = reinterpret_cast<std::uintptr_t>(buffer.data());
+
+    auto pattern = gensokyo::pattern::Type("? 89 5C 24 ? 57");
+
+    // 0x57 is the rarest byte in x86 code of the ones in the pattern
+    REQUIRE(gensokyo::pattern::impl::find_anchor(pattern.bytes) == 5);
+
+    REQUIRE(gensokyo::pattern::impl::find_std(buffer.data(), buffer.size(), pattern.bytes).ptr == base + 0x800);
+    REQUIRE(gensokyo::pattern::impl::find_simd<gensokyo::simd::iSSE>(buffer.data(), buffer.size(), pattern.bytes).ptr == base + 0x800);
+    REQUIRE(gensokyo::pattern::impl::find_simd<gensokyo::simd::iAVX2>(buffer.data(), buffer.size(), pattern.bytes).ptr == base + 0x800);
+    REQUIRE(gensokyo::pattern::find(buffer, pattern).ptr == base + 0x800);
+
+    // nothing to anchor on, the first position matches
+    auto wildcards = gensokyo::pattern::Type("? ? ?");
+    REQUIRE(gensokyo::pattern::impl::find_anchor(wildcards.bytes) == wildcards.size());
+    REQUIRE(gensokyo::pattern::find(buffer, wildcards).ptr == base);
+}
+
+TEST_CASE("DualAnchor", "FindPattern")
+{
+    // both anchors are common in x86 code and every other position has them in place
+    std::vector<std::uint8_t> buffer(0x1000, 0x00);
+    for (std::size_t i = 0; i < buffer.size(); i += 2)
+        buffer[i] = 0x8B;
+    std::ranges::copy(std::initializer_list<std::uint8_t> { 0x48, 0x8B, 0x00, 0x8B }, buffer.begin() + 0xA01);
+    const auto base = reinterpret_cast<std::uintptr_t>(buffer.data());
+
+    auto pattern = gensokyo::pattern::Type("48 8B ? 8B");
+    gensokyo::pattern::impl::ScanState state(buffer.data(), buffer.size(), pattern.bytes);
+    REQUIRE(gensokyo::pattern::impl::prefer_dual_anchor(state));
+
+    REQUIRE(gensokyo::pattern::impl::find_simd<gensokyo::simd::iSSE, true>(buffer.data(), buffer.size(), pattern.bytes).ptr == base + 0xA01);
+    REQUIRE(gensokyo::pattern::impl::find_simd<gensokyo::simd::iAVX2, true>(buffer.data(), buffer.size(), pattern.bytes).ptr == base + 0xA01);
+    REQUIRE(gensokyo::pattern::find(buffer, pattern).ptr == base + 0xA01);
+
+    // a rare anchor filters well enough on its own
+    auto rare = gensokyo::pattern::Type("48 8B ? A2");
+    REQUIRE_FALSE(gensokyo::pattern::impl::prefer_dual_anchor(gensokyo::pattern::impl::ScanState(buffer.data(), buffer.size(), rare.bytes)));
+}
+
+TEST_CASE("NibbleWildcard", "FindPattern")
+{
+    // mov rax, [rip + x] and mov rcx, [rip + x] only differ in the reg field of ModRM
+    std::vector<std::uint8_t> buffer(0x1000, 0xCC);
+    std::ranges::copy(std::initializer_list<std::uint8_t> { 0x48, 0x8B, 0x0D, 0x11, 0x22, 0x33, 0x44 }, buffer.begin() + 0x300);
+    std::ranges::copy(std::initializer_list<std::uint8_t> { 0x48, 0x8B, 0x05, 0x11, 0x22, 0x33, 0x44 }, buffer.begin() + 0x900);
+    const auto base = reinterpret_cast<std::uintptr_t>(buffer.data());
+
+    auto pattern = gensokyo::pattern::Type("48 8B ?5 ? ? ? ?");
+    auto check   = [&](gensokyo::Address result)
+    {
+        REQUIRE(result.ptr == base + 0x900);
+    };
+
+    SECTION("BruteForce")
+    {
+        check(gensokyo::pattern::impl::find_brute_force(buffer.data(), buffer.size(), pattern.bytes));
+    }
+
+    SECTION("std")
+    {
+        check(gensokyo::pattern::impl::find_std(buffer.data(), buffer.size(), pattern.bytes));
+    }
+
+    SECTION("SIMD_SSE")
+    {
+        check(gensokyo::pattern::impl::find_simd<gensokyo::simd::iSSE>(buffer.data(), buffer.size(), pattern.bytes));
+    }
+
+    SECTION("SIMD_AVX2")
+    {
+        check(gensokyo::pattern::impl::find_simd<gensokyo::simd::iAVX2>(buffer.data(), buffer.size(), pattern.bytes));
+    }
+
+    SECTION("FindMany")
+    {
+        // const, so a fixed table of signatures can be passed as it is
+        const std::vector<gensokyo::pattern::Type> patterns { pattern, gensokyo::pattern::Type("0? 8B") };
+        const auto results = gensokyo::pattern::find_many(buffer, patterns);
+        REQUIRE(results[0].ptr == base + 0x900);
+        REQUIRE(results[1].ptr == 0);
+    }
+
+    SECTION("AnchorOnNibble")
+    {
+        // no concrete byte, the scan anchors on the partly known one
+        auto nibbles = gensokyo::pattern::Type("4? ? ?5");
+        REQUIRE(gensokyo::pattern::impl::find_anchor(nibbles.bytes) == 0);
+        REQUIRE(gensokyo::pattern::find(buffer, nibbles).ptr == base + 0x900);
+        REQUIRE(gensokyo::pattern::impl::find_simd<gensokyo::simd::iSSE>(buffer.data(), buffer.size(), nibbles.bytes).ptr == base + 0x900);
+    }
+}
+
+TEST_CASE("CompileTime", "FindPattern")
+{
+    std::vector<std::uint8_t> buffer(0x1000, 0xCC);
+    std::ranges::copy(std::initializer_list<std::uint8_t> { 0x48, 0x8B, 0x05, 0x11, 0x22, 0x33, 0x44, 0x89 }, buffer.begin() + 0x777);
+    std::ranges::copy(std::initializer_list<std::uint8_t> { 0x48, 0x8B, 0x0D, 0x11, 0x22, 0x33, 0x44, 0x89 }, buffer.begin() + 0xFF8);
+    const auto base = reinterpret_cast<std::uintptr_t>(buffer.data());
+
+    REQUIRE(gensokyo::pattern::find<"48 8B ? ? ? ? ? 89">(buffer).ptr == base + 0x777);
+    REQUIRE(gensokyo::pattern::find<"48 8B ?D ? ? ? ? 89">(buffer).ptr == base + 0xFF8);
+    REQUIRE(gensokyo::pattern::find<"? 8B 05">(buffer).ptr == base + 0x777);
+    REQUIRE(gensokyo::pattern::find<"? ?">(buffer).ptr == base);
+    REQUIRE(gensokyo::pattern::find<"48 8B 05 11 22 33 44 88">(buffer).ptr == 0);
+
+    SECTION("SIMD_SSE")
+    {
+        REQUIRE(gensokyo::pattern::impl::find_compiled<gensokyo::simd::iSSE, "48 8B ?D ? ? ? ? 89">(buffer.data(), buffer.size()).ptr == base + 0xFF8);
+    }
+
+    SECTION("SIMD_AVX2")
+    {
+        REQUIRE(gensokyo::pattern::impl::find_compiled<gensokyo::simd::iAVX2, "48 8B ?D ? ? ? ? 89">(buffer.data(), buffer.size()).ptr == base + 0xFF8);
+    }
+}
+
+TEST_CASE("LongPattern", "FindPattern")
+{
+    // 90 bytes, longer than a register of every backend
+    std::vector<std::uint8_t> signature(90);
+    for (std::size_t i = 0; i < signature.size(); i++)
+        signature[i] = static_cast<std::uint8_t>(0x40 + i);
+
+    std::string text {};
+    for (std::size_t i = 0; i < signature.size(); i++)
+        text += i % 9 == 4 ? "? " : fmt::format("{:02X} ", signature[i]);
+    text.pop_back();
+    auto pattern = gensokyo::pattern::Type(text);
+
+    std::vector<std::uint8_t> buffer(0x1000, 0xCC);
+    const auto base = reinterpret_cast<std::uintptr_t>(buffer.data());
+
+    // differs only in the last byte, so every register but the last one matches
+    std::ranges::copy(signature, buffer.begin() + 0x100);
+    buffer[0x100 + signature.size() - 1] = 0;
+    std::ranges::copy(signature, buffer.begin() + 0x400);
+    std::ranges::copy(signature, buffer.begin() + 0x1000 - signature.size());
+
+    auto check = [&](gensokyo::Address result)
+    {
+        REQUIRE(result.ptr == base + 0x400);
+    };
+
+    SECTION("SIMD_SSE")
+    {
+        check(gensokyo::pattern::impl::find_simd<gensokyo::simd::iSSE>(buffer.data(), buffer.size(), pattern.bytes));
+    }
+
+    SECTION("SIMD_AVX2")
+    {
+        check(gensokyo::pattern::impl::find_simd<gensokyo::simd::iAVX2>(buffer.data(), buffer.size(), pattern.bytes));
+    }
+
+#if defined(GENSOKYO_SIMD_AVX512)
+    SECTION("SIMD_AVX512")
+    {
+        if (gensokyo::cpu.get_arch() == gensokyo::CPUArch::AVX512)
+            check(gensokyo::pattern::impl::find_simd<gensokyo::simd::iAVX512>(buffer.data(), buffer.size(), pattern.bytes));
+    }
+#endif
+
+    SECTION("FindAll")
+    {
+        std::vector<std::uintptr_t> results {};
+        for (const auto address : gensokyo::pattern::find_all(buffer, pattern))
+            results.push_back(address.ptr - base);
+
+        REQUIRE(results == std::vector<std::uintptr_t> { 0x400, 0x1000 - signature.size() });
+    }
+
+    SECTION("ScanStateLimit")
+    {
+        // the longest pattern the kernels verify themselves, and one byte more which goes to find_std
+        static_assert(gensokyo::pattern::impl::ScanState::max_simd_pattern == 256);
+        for (const std::size_t size : { 256, 257 })
+        {
+            std::vector<std::uint8_t> bytes(size);
+            for (std::size_t i = 0; i < bytes.size(); i++)
+                bytes[i] = static_cast<std::uint8_t>(i * 7 + 1);
+
+            std::string long_text {};
+            for (const auto byte : bytes)
+                long_text += fmt::format("{:02X} ", byte);
+            long_text.pop_back();
+            auto long_pattern = gensokyo::pattern::Type(long_text);
+
+            std::vector<std::uint8_t> data(0x1000, 0xCC);
+            std::ranges::copy(bytes, data.begin() + 0x100);
+            data[0x100 + size - 1] ^= 0xFF;
+            std::ranges::copy(bytes, data.begin() + 0x600);
+
+            const auto expected = reinterpret_cast<std::uintptr_t>(data.data()) + 0x600;
+            REQUIRE(gensokyo::pattern::impl::find_simd<gensokyo::simd::iSSE>(data.data(), data.size(), long_pattern.bytes).ptr == expected);
+            REQUIRE(gensokyo::pattern::impl::find_simd<gensokyo::simd::iAVX2>(data.data(), data.size(), long_pattern.bytes).ptr == expected);
+            REQUIRE(gensokyo::pattern::find(data, long_pattern).ptr == expected);
+        }
+    }
+}
+
+TEST_CASE("Parallel", "FindPattern")
+{
+    std::vector<std::uint8_t> buffer(16 * 1024 * 1024, 0xCC);
+    auto write = [&](std::size_t offset)
+    {
+        std::ranges::copy(std::initializer_list<std::uint8_t> { 0x48, 0x8B, 0x05, 0x11, 0x22, 0x33, 0x44, 0xC3 }, buffer.begin() + offset);
+    };
+
+    const auto base = reinterpret_cast<std::uintptr_t>(buffer.data());
+    auto pattern    = gensokyo::pattern::Type("48 8B 05 ? ? ? ? C3");
+
+    REQUIRE(gensokyo::pattern::find(gensokyo::pattern::parallel, buffer, pattern).ptr == 0);
+
+    // only match is in the last chunk
+    write(buffer.size() - 8);
+    REQUIRE(gensokyo::pattern::find(gensokyo::pattern::parallel, buffer, pattern).ptr == base + buffer.size() - 8);
+
+    // crosses a chunk boundary
+    write(0x7FFFC);
+    REQUIRE(gensokyo::pattern::find(gensokyo::pattern::parallel, buffer, pattern).ptr == base + 0x7FFFC);
+
+    // lowest match wins even though later chunks finish first
+    write(0x100);
+    REQUIRE(gensokyo::pattern::find(gensokyo::pattern::parallel, buffer, pattern).ptr == base + 0x100);
+}
+
 TEST_CASE("PatternBenchmark", "FindPattern")
 {
     // Setup data to find
@@ -339,6 +677,21 @@ TEST_CASE("PatternBenchmark", "FindPattern")
         }
     }
 
+#if defined(GENSOKYO_SIMD_AVX512)
+    SECTION("SIMD_AVX512")
+    {
+        if (gensokyo::cpu.get_arch() == gensokyo::CPUArch::AVX512)
+        {
+            for (auto&& pattern : patterns)
+            {
+                auto res = gensokyo::pattern::impl::find_simd<gensokyo::simd::iAVX512>(buffer.data(), buffer.size(), pattern.pattern.bytes);
+                INFO("Scanning " << pattern.name);
+                REQUIRE(buffer_data_ + pattern.offset == res.ptr);
+            }
+        }
+    }
+#endif
+
     SECTION("SIMD_AVX2")
     {
         for (auto&& pattern : patterns)
@@ -349,6 +702,16 @@ TEST_CASE("PatternBenchmark", "FindPattern")
         }
     }
 
+    SECTION("SIMD_AVX2_DualAnchor")
+    {
+        for (auto&& pattern : patterns)
+        {
+            auto res = gensokyo::pattern::impl::find_simd<gensokyo::simd::iAVX2, true>(buffer.data(), buffer.size(), pattern.pattern.bytes);
+            INFO("Scanning " << pattern.name);
+            REQUIRE(buffer_data_ + pattern.offset == res.ptr);
+        }
+    }
+
     SECTION("SIMD_SSE")
     {
         for (auto&& pattern : patterns)
@@ -368,6 +731,42 @@ TEST_CASE("PatternBenchmark", "FindPattern")
         }
     }
 
+    std::vector<gensokyo::pattern::Type> pattern_list {};
+    for (auto&& pattern : patterns)
+        pattern_list.push_back(pattern.pattern);
+
+    SECTION("Parallel")
+    {
+        for (auto&& pattern : patterns)
+        {
+            auto res = gensokyo::pattern::find(gensokyo::pattern::parallel, buffer, pattern.pattern);
+            INFO("Scanning " << pattern.name);
+            REQUIRE(buffer_data_ + pattern.offset == res.ptr);
+        }
+    }
+
+    SECTION("FindAll")
+    {
+        for (auto&& pattern : patterns)
+        {
+            auto matches = gensokyo::pattern::find_all(buffer, pattern.pattern);
+            auto it      = matches.begin();
+            INFO("Scanning " << pattern.name);
+            REQUIRE(it != matches.end());
+            REQUIRE(buffer_data_ + pattern.offset == (*it).ptr);
+        }
+    }
+
+    SECTION("FindMany")
+    {
+        auto res = gensokyo::pattern::find_many(buffer, pattern_list);
+        for (std::size_t i = 0; i < patterns.size(); i++)
+        {
+            INFO("Scanning " << patterns[i].name);
+            REQUIRE(buffer_data_ + patterns[i].offset == res[i].ptr);
+        }
+    }
+
     SECTION("Benchmark")
     {
         BENCHMARK_ADVANCED("BruteForce")(Catch::Benchmark::Chronometer meter)
@@ -409,6 +808,19 @@ TEST_CASE("PatternBenchmark", "FindPattern")
                   }
               });
         };
+        BENCHMARK_ADVANCED("SIMD_AVX2_DualAnchor")(Catch::Benchmark::Chronometer meter)
+        {
+            meter.measure(
+              [&]
+              {
+                  for (auto&& pattern : patterns)
+                  {
+                      auto res = gensokyo::pattern::impl::find_simd<gensokyo::simd::iAVX2, true>(buffer.data(), buffer.size(), pattern.pattern.bytes);
+                      INFO("Scanning " << pattern.name);
+                      REQUIRE(buffer_data_ + pattern.offset == res.ptr);
+                  }
+              });
+        };
         BENCHMARK_ADVANCED("SIMD_SSE")(Catch::Benchmark::Chronometer meter)
         {
             meter.measure(
@@ -435,5 +847,31 @@ TEST_CASE("PatternBenchmark", "FindPattern")
                   }
               });
         };
+        BENCHMARK_ADVANCED("Parallel")(Catch::Benchmark::Chronometer meter)
+        {
+            meter.measure(
+              [&]
+              {
+                  for (auto&& pattern : patterns)
+                  {
+                      auto res = gensokyo::pattern::find(gensokyo::pattern::parallel, buffer, pattern.pattern);
+                      INFO("Scanning " << pattern.name);
+                      REQUIRE(buffer_data_ + pattern.offset == res.ptr);
+                  }
+              });
+        };
+        BENCHMARK_ADVANCED("FindMany")(Catch::Benchmark::Chronometer meter)
+        {
+            meter.measure(
+              [&]
+              {
+                  auto res = gensokyo::pattern::find_many(buffer, pattern_list);
+                  for (std::size_t i = 0; i < patterns.size(); i++)
+                  {
+                      INFO("Scanning " << patterns[i].name);
+                      REQUIRE(buffer_data_ + patterns[i].offset == res[i].ptr);
+                  }
+              });
+        };
     }
 }
\ No newline at end of file
@@ -0,0 +1,60 @@
+#include <gensokyo.hpp>
+#include <catch2/catch_all.hpp>
+#include "buffer_process.hpp"
+#include <array>
+#include <vector>
+
+TEST_CASE("PointerResolver", "Process")
+{
+    alignas(0x1000) static std::array<std::uintptr_t, 0x1000> heap {};
+    heap = {};
+
+    const auto at = [&](std::size_t index)
+    {
+        return reinterpret_cast<std::uintptr_t>(&heap[index]);
+    };
+
+    heap[0]  = at(10);
+    heap[11] = at(20);
+    heap[2]  = at(30);
+
+    BufferProcess process {};
+    process.bad_begin = at(0x800);
+    process.bad_end   = at(0x801);
+
+    gensokyo::PointerResolver resolver(process);
+    REQUIRE(resolver.add({ at(0), { 0x8, 0x10 } }) == 0);
+    resolver.add({ at(1), { 0x8 } });
+    resolver.add({ at(3), {} });
+    resolver.add({ at(2), { 0x4 } });
+    resolver.add({ at(0x800), { 0x0 } });
+
+    REQUIRE(resolver.resolve() == 3);
+    REQUIRE(process.batches == 2);
+
+    REQUIRE(resolver.result(0).ptr == at(22));
+    // a null pointer on the way
+    REQUIRE(resolver.result(1).ptr == 0);
+    REQUIRE(resolver.result(2).ptr == at(3));
+    REQUIRE(resolver.result(3).ptr == at(30) + 4);
+    // a failed read
+    REQUIRE(resolver.result(4).ptr == 0);
+
+    SECTION("ManyChains")
+    {
+        // 500 chains of 5 levels, every pointer goes 8 slots further
+        for (std::size_t i = 0; i < 0x400; i++)
+            heap[i] = at(i + 8);
+
+        std::vector<gensokyo::PointerResolver::Chain> chains {};
+        for (std::size_t i = 0; i < 500; i++)
+            chains.push_back({ at(i), { 0, 0, 0, 0, 8 } });
+
+        process.batches   = 0;
+        const auto result = gensokyo::PointerResolver::resolve(process, chains);
+        REQUIRE(process.batches == 5);
+
+        for (std::size_t i = 0; i < chains.size(); i++)
+            REQUIRE(result[i].ptr == at(i + 40) + 8);
+    }
+}
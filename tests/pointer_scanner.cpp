@@ -0,0 +1,120 @@
+#include <gensokyo.hpp>
+#include <catch2/catch_all.hpp>
+#include "buffer_process.hpp"
+#include <array>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+TEST_CASE("PointerScanner", "Process")
+{
+    // the headers in the first page, the data in the second
+    alignas(0x1000) static std::array<std::uintptr_t, 0x400> module {};
+    alignas(0x1000) static std::array<std::uintptr_t, 0x800> heap {};
+    module = {};
+    heap   = {};
+    write_image_header(module.data(), sizeof(module));
+
+    const auto data = reinterpret_cast<std::uintptr_t>(module.data()) + 0x1000;
+
+    // module+0x1010 -> object+0x20 -> object+0x8
+    const auto link = [&](std::size_t first, std::size_t second)
+    {
+        module[0x202]   = reinterpret_cast<std::uintptr_t>(&heap[first]);
+        heap[first + 4] = reinterpret_cast<std::uintptr_t>(&heap[second]);
+        return reinterpret_cast<std::uintptr_t>(&heap[second + 1]);
+    };
+
+    BufferProcess process {};
+    process.mappings.push_back({ { reinterpret_cast<std::uintptr_t>(module.data()), 0x1000 }, true, false, false, true, "/usr/lib/libgame.so", 0 });
+    process.mappings.push_back({ { data, 0x1000 }, true, true, false, true, "/usr/lib/libgame.so", 0x1000 });
+    process.mappings.push_back({ { reinterpret_cast<std::uintptr_t>(heap.data()), sizeof(heap) }, true, true, false, false, "[heap]" });
+    std::ranges::sort(process.mappings, {}, &gensokyo::impl::Region::address);
+
+    const auto target = link(0x20, 0x100);
+
+    gensokyo::PointerScanner::Options options {};
+    options.max_offset = 0x100;
+
+    gensokyo::PointerScanner scanner(process, options);
+    scanner.snapshot();
+    REQUIRE(scanner.pointer_count() == 2);
+
+    const auto results = scanner.scan(target);
+    REQUIRE(results.size() == 1);
+    REQUIRE(results.front().to_string() == "libgame.so+0x1010,0x20,0x8");
+    REQUIRE(scanner.resolve(results.front()) == target);
+
+    SECTION("Limits")
+    {
+        options.max_depth = 1;
+        REQUIRE(gensokyo::PointerScanner(process, options).scan(target).empty());
+
+        // the module pointer also reaches the target directly once the offset allows it
+        options.max_depth  = 5;
+        options.max_offset = 0x1000;
+        REQUIRE(gensokyo::PointerScanner(process, options).scan(target).size() == 2);
+    }
+
+    SECTION("SameName")
+    {
+        // another file with the same name is its own module, offsets into it are from its own base
+        alignas(0x1000) static std::array<std::uintptr_t, 0x400> other {};
+        other = {};
+        write_image_header(other.data(), sizeof(other));
+        other[0x206] = module[0x202];
+
+        const auto other_data = reinterpret_cast<std::uintptr_t>(other.data()) + 0x1000;
+        process.mappings.push_back({ { reinterpret_cast<std::uintptr_t>(other.data()), 0x1000 }, true, false, false, true, "/opt/mods/libgame.so", 0 });
+        process.mappings.push_back({ { other_data, 0x1000 }, true, true, false, true, "/opt/mods/libgame.so", 0x1000 });
+        std::ranges::sort(process.mappings, {}, &gensokyo::impl::Region::address);
+
+        gensokyo::PointerScanner both(process, options);
+        both.snapshot();
+
+        std::vector<std::string> paths {};
+        for (const auto& path : both.scan(target))
+            paths.push_back(path.to_string());
+
+        std::ranges::sort(paths);
+        REQUIRE(paths == std::vector<std::string> { "libgame.so+0x1010,0x20,0x8", "libgame.so+0x1030,0x20,0x8" });
+    }
+
+    SECTION("Rescan")
+    {
+        const auto file = std::filesystem::temp_directory_path() / "gensokyo_pointer_paths.txt";
+
+        auto paths = results;
+        paths.push_back(*gensokyo::PointerPath::parse("libgame.so+0x1018,0x20,0x8"));
+        paths.push_back(*gensokyo::PointerPath::parse("libother.so+0x10,0x20,0x8"));
+        gensokyo::PointerScanner::save(file, paths);
+
+        // the made up path reads a null pointer, which the buffer can't fail on its own
+        process.bad_begin = 0;
+        process.bad_end   = 0x10000;
+
+        // the objects moved, like after a restart
+        heap              = {};
+        const auto moved  = link(0x300, 0x500);
+        const auto loaded = gensokyo::PointerScanner::load(file);
+        std::filesystem::remove(file);
+
+        REQUIRE(loaded == paths);
+        REQUIRE(gensokyo::PointerScanner(process).rescan(loaded, moved) == results);
+    }
+
+    SECTION("Parse")
+    {
+        const auto path = gensokyo::PointerPath::parse("Game Client+x64.exe+0x1a2b0,0x10,0x0");
+        REQUIRE(path);
+        REQUIRE(path->module == "Game Client+x64.exe");
+        REQUIRE(path->offset == 0x1A2B0);
+        REQUIRE(path->offsets == std::vector<std::uintptr_t> { 0x10, 0 });
+        REQUIRE(gensokyo::PointerPath::parse(path->to_string()) == path);
+
+        REQUIRE(!gensokyo::PointerPath::parse("game.exe"));
+        REQUIRE(!gensokyo::PointerPath::parse("game.exe+0x10,"));
+        REQUIRE(!gensokyo::PointerPath::parse("game.exe+10"));
+        REQUIRE(!gensokyo::PointerPath::parse("game.exe+0x10,0xZZ"));
+    }
+}
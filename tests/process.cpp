@@ -0,0 +1,130 @@
+#include <gensokyo.hpp>
+#include <catch2/catch_all.hpp>
+#include "buffer_process.hpp"
+#include <algorithm>
+#include <vector>
+
+TEST_CASE("ProcessScan", "FindPattern")
+{
+    std::vector<std::uint8_t> buffer(0x10000, 0xCC);
+    const auto base = reinterpret_cast<std::uintptr_t>(buffer.data());
+
+    auto pattern = gensokyo::pattern::Type("48 8B 05 ? ? ? ? C3");
+    const std::vector<std::size_t> offsets { 0x10, 0xFFC, 0x1FFF, 0x2FF9, 0x8000, 0xFFF8 };
+    for (const auto offset : offsets)
+        std::ranges::copy(std::initializer_list<std::uint8_t> { 0x48, 0x8B, 0x05, 0x11, 0x22, 0x33, 0x44, 0xC3 }, buffer.begin() + offset);
+
+    BufferProcess process {};
+    const gensokyo::impl::MemoryRegion region { base, buffer.size() };
+
+    const auto to_offsets = [&](const std::vector<gensokyo::Address>& results)
+    {
+        std::vector<std::size_t> values {};
+        for (const auto result : results)
+            values.push_back(result.ptr - base);
+
+        return values;
+    };
+
+    SECTION("ChunkBoundaries")
+    {
+        // chunk sizes where matches start right before a boundary, cross one, or span several chunks
+        for (const std::size_t chunk_size : { 3, 7, 8, 0x1000, 0x3000, 0x10000, 0x20000 })
+        {
+            REQUIRE(process.find(region, pattern, chunk_size).ptr == base + offsets.front());
+            REQUIRE(to_offsets(process.find_all(region, pattern, chunk_size)) == offsets);
+        }
+
+        REQUIRE(process.find({ base + 0x11, 0x1000 }, pattern).ptr == base + 0xFFC);
+        REQUIRE(process.find({ base + 0x11, 0xFF0 }, pattern).ptr == 0);
+    }
+
+    SECTION("StopsAtFirstMatch")
+    {
+        REQUIRE(process.find(region, pattern, 0x1000).ptr == base + 0x10);
+
+        // the chunk with the match, and the one read ahead of it only when a worker started on it before the match was found
+        REQUIRE(process.reads >= 1);
+        REQUIRE(process.reads <= 2);
+    }
+
+    SECTION("UnreadableChunk")
+    {
+        process.bad_begin = base + 0x2000;
+        process.bad_end   = base + 0x2001;
+
+        // matches in the chunk that fails, or crossing into it, are lost, the scan goes on after it
+        REQUIRE(to_offsets(process.find_all(region, pattern, 0x1000)) == std::vector<std::size_t> { 0x10, 0xFFC, 0x8000, 0xFFF8 });
+    }
+
+    SECTION("FromThreadPool")
+    {
+        // every worker waits on a scan that reads ahead on the pool, the scan has to do the reads itself
+        std::vector<std::size_t> found(gensokyo::thread_pool.size() + 1);
+        gensokyo::thread_pool.parallel_for(found.size(),
+                                           [&](std::size_t index)
+                                           {
+                                               found[index] = to_offsets(process.find_all(region, pattern, 0x100)).size();
+                                           });
+
+        REQUIRE(std::ranges::all_of(found,
+                                    [&](std::size_t count)
+                                    {
+                                        return count == offsets.size();
+                                    }));
+    }
+}
+
+TEST_CASE("ReadMany", "Process")
+{
+    std::vector<std::uint8_t> buffer(0x40000);
+    for (std::size_t i = 0; i < buffer.size(); i++)
+        buffer[i] = static_cast<std::uint8_t>(i * 7);
+
+    const auto base = reinterpret_cast<std::uintptr_t>(buffer.data());
+
+    // unsorted, close together, far apart, and one empty request
+    const std::vector<std::pair<std::size_t, std::size_t>> ranges { { 0x100, 8 }, { 0x10, 4 }, { 0x20000, 16 }, { 0x108, 8 }, { 0x3FFF0, 16 }, { 0x300, 0 }, { 0x200, 32 } };
+
+    std::vector<std::vector<std::uint8_t>> results(ranges.size());
+    std::vector<gensokyo::impl::ReadRequest> requests {};
+    for (std::size_t i = 0; i < ranges.size(); i++)
+    {
+        results[i].resize(ranges[i].second);
+        requests.push_back({ base + ranges[i].first, results[i].data(), ranges[i].second });
+    }
+
+    const auto check = [&](std::size_t i)
+    {
+        return std::equal(results[i].begin(), results[i].end(), buffer.begin() + ranges[i].first);
+    };
+
+    BufferProcess process {};
+
+    SECTION("Coalesced")
+    {
+        REQUIRE(process.read_many(requests) == requests.size());
+        for (std::size_t i = 0; i < requests.size(); i++)
+        {
+            REQUIRE(requests[i].success);
+            REQUIRE(check(i));
+        }
+
+        // 0x10 to 0x220 is one read, the other two are too far away
+        REQUIRE(process.reads == 3);
+    }
+
+    SECTION("BadAddress")
+    {
+        process.bad_begin = base + 0x200;
+        process.bad_end   = base + 0x201;
+
+        // the merged read fails, everything but the bad request is read again on its own
+        REQUIRE(process.read_many(requests) == requests.size() - 1);
+        for (std::size_t i = 0; i < requests.size(); i++)
+        {
+            REQUIRE(requests[i].success == (i != 6));
+            REQUIRE((!requests[i].success || check(i)));
+        }
+    }
+}
@@ -0,0 +1,132 @@
+#include <gensokyo.hpp>
+#include <catch2/catch_all.hpp>
+#include "buffer_process.hpp"
+#include <array>
+#include <vector>
+
+TEST_CASE("RemotePtr", "Process")
+{
+    struct Entity
+    {
+        std::int32_t health {};
+        float position[3] {};
+        std::uint8_t padding[0x2000] {};
+        Entity* target {};
+        std::uint32_t id {};
+    };
+
+    static std::array<Entity, 8> entities {};
+    for (std::size_t i = 0; i < entities.size(); i++)
+    {
+        entities[i]        = {};
+        entities[i].health = static_cast<std::int32_t>(100 + i);
+        entities[i].id     = static_cast<std::uint32_t>(i);
+        entities[i].target = &entities[(i + 1) % entities.size()];
+    }
+
+    entities[3].target = nullptr;
+
+    BufferProcess process {};
+    gensokyo::RemotePtr<Entity> entity(process, &entities[0]);
+    entity.field(&Entity::health).field(&Entity::position).field(&Entity::target).field(&Entity::id);
+
+    REQUIRE_FALSE(entity.fetched());
+    REQUIRE(entity.get(&Entity::health) == 100);
+    REQUIRE(entity.valid());
+
+    // health and position touch so they're one read, the padding between them and the rest isn't read
+    REQUIRE(process.batches == 1);
+    REQUIRE(process.reads == 2);
+    REQUIRE(entity->id == 0);
+    REQUIRE(entity.get(&Entity::target) == &entities[1]);
+    REQUIRE(process.batches == 1);
+
+    SECTION("Follow")
+    {
+        auto target = entity.follow(&Entity::target);
+        REQUIRE(target.address().ptr == reinterpret_cast<std::uintptr_t>(&entities[1]));
+        // nothing named reads the whole struct
+        auto next = target.follow(&Entity::target);
+        REQUIRE(next->health == 102);
+        REQUIRE(next->id == 2);
+
+        // following names the pointer field, the other fields of target aren't read
+        REQUIRE(target->id == 0);
+
+        // a null pointer isn't read
+        const auto reads = process.reads.load();
+        gensokyo::RemotePtr<Entity> null(process, 0);
+        REQUIRE(null->health == 0);
+        REQUIRE_FALSE(null.valid());
+        REQUIRE(process.reads == reads);
+    }
+
+    SECTION("FieldAfterFetch")
+    {
+        entities[0].padding[0x10] = 7;
+        REQUIRE(entity.get(&Entity::padding)[0x10] == 7);
+        REQUIRE(process.batches == 2);
+        REQUIRE(entity->health == 100);
+    }
+
+    SECTION("FetchAll")
+    {
+        std::vector<gensokyo::RemotePtr<Entity>> pointers {};
+        for (auto& current : entities)
+            pointers.emplace_back(process, &current).field(&Entity::health).field(&Entity::target);
+
+        process.bad_begin = reinterpret_cast<std::uintptr_t>(&entities[5].health);
+        process.bad_end   = process.bad_begin + 1;
+        process.batches   = 0;
+
+        REQUIRE(gensokyo::RemotePtr<Entity>::fetch_all(pointers) == entities.size() - 1);
+        REQUIRE(process.batches == 1);
+
+        for (std::size_t i = 0; i < pointers.size(); i++)
+        {
+            REQUIRE(pointers[i].valid() == (i != 5));
+            REQUIRE(pointers[i]->health == (i == 5 ? 0 : static_cast<std::int32_t>(100 + i)));
+        }
+
+        REQUIRE(pointers[3]->target == nullptr);
+        REQUIRE(process.batches == 1);
+
+        // the next tick reads again
+        entities[2].health = 5;
+        pointers[2].invalidate();
+        REQUIRE(pointers[2]->health == 5);
+    }
+
+    SECTION("Unbound")
+    {
+        // a default constructed pointer has no process to read or follow through
+        gensokyo::RemotePtr<Entity> unbound {};
+        REQUIRE_FALSE(unbound.fetch());
+        REQUIRE_FALSE(unbound.follow(&Entity::target).fetch());
+
+        std::vector<gensokyo::RemotePtr<Entity>> pointers(2);
+        REQUIRE(gensokyo::RemotePtr<Entity>::fetch_all(pointers) == 0);
+
+        pointers.emplace_back(process, &entities[4]).field(&Entity::health);
+        REQUIRE(gensokyo::RemotePtr<Entity>::fetch_all(pointers) == 1);
+        REQUIRE(pointers.back()->health == 104);
+    }
+
+    SECTION("FetchAllProcesses")
+    {
+        // every pointer is read through its own process, one batch each
+        BufferProcess other {};
+        std::vector<gensokyo::RemotePtr<Entity>> pointers {};
+        for (std::size_t i = 0; i < entities.size(); i++)
+            pointers.emplace_back(i % 2 ? other : process, &entities[i]).field(&Entity::id);
+
+        process.batches = 0;
+        REQUIRE(gensokyo::RemotePtr<Entity>::fetch_all(pointers) == entities.size());
+        REQUIRE(process.batches == 1);
+        REQUIRE(other.batches == 1);
+        REQUIRE(other.reads == entities.size() / 2);
+
+        for (std::size_t i = 0; i < pointers.size(); i++)
+            REQUIRE(pointers[i]->id == i);
+    }
+}
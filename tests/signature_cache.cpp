@@ -0,0 +1,149 @@
+#include <gensokyo.hpp>
+#include <catch2/catch_all.hpp>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace
+{
+    // a pattern made from code of this test, with a wildcard so it goes through the masked paths too
+    std::vector<gensokyo::pattern::impl::HexData> pattern_from(const gensokyo::impl::Segments& segment, std::size_t offset, std::size_t size)
+    {
+        std::vector<gensokyo::pattern::impl::HexData> pattern {};
+        for (std::size_t i = 0; i < size; i++)
+        {
+            if (i == 3)
+                pattern.emplace_back(std::nullopt);
+            else
+                pattern.emplace_back(segment.data[offset + i]);
+        }
+
+        return pattern;
+    }
+
+    struct TempFile
+    {
+        std::filesystem::path path = std::filesystem::temp_directory_path() / "gensokyo_signature_cache.bin";
+
+        TempFile()
+        {
+            std::filesystem::remove(path);
+        }
+
+        ~TempFile()
+        {
+            std::filesystem::remove(path);
+        }
+    };
+}
+
+TEST_CASE("SignatureCache", "[signature_cache]")
+{
+    using gensokyo::SignatureCache;
+
+    TempFile file {};
+    gensokyo::impl::Module module("");
+
+    REQUIRE(module.identity().size != 0);
+    REQUIRE(!module.get_segments().empty());
+
+    const auto& segment = module.get_segments().front();
+    REQUIRE(segment.data.size() > 0x200);
+
+    const auto bytes   = pattern_from(segment, segment.data.size() / 2, 24);
+    const auto pattern = gensokyo::pattern::impl::PatternView(bytes);
+    const auto key     = SignatureCache::hash(pattern);
+    const auto address = gensokyo::pattern::find(segment.data, pattern);
+
+    REQUIRE(address.ptr != 0);
+
+    SECTION("ResolveAndReopen")
+    {
+        {
+            SignatureCache cache(file.path);
+            REQUIRE(cache.size() == 0);
+            REQUIRE(!cache.lookup(module.identity(), key));
+
+            REQUIRE(cache.find(module, pattern).ptr == address.ptr);
+            REQUIRE(cache.size() == 1);
+            REQUIRE(cache.lookup(module.identity(), key) == address.ptr - module.base());
+        }
+
+        // a new cache on the same file finds the entry without scanning
+        SignatureCache cache(file.path);
+        REQUIRE(cache.size() == 1);
+        REQUIRE(cache.lookup(module.identity(), key) == address.ptr - module.base());
+        REQUIRE(cache.find(module, pattern).ptr == address.ptr);
+
+        // another build of the module doesn't see it
+        REQUIRE(!cache.lookup({ module.identity().build + 1, module.identity().size }, key));
+    }
+
+    SECTION("StaleEntry")
+    {
+        SignatureCache cache(file.path);
+
+        // an offset that doesn't match anymore is rescanned and replaced
+        cache.store(module.identity(), key, 0);
+        REQUIRE(cache.find(module, pattern).ptr == address.ptr);
+        REQUIRE(cache.lookup(module.identity(), key) == address.ptr - module.base());
+        REQUIRE(cache.size() == 1);
+
+        // so is one that points outside of every segment
+        cache.store(module.identity(), key, module.size() + 0x1000);
+        REQUIRE(cache.find(module, pattern).ptr == address.ptr);
+    }
+
+    SECTION("Grow")
+    {
+        SignatureCache cache(file.path);
+
+        for (std::uint64_t i = 1; i <= 5000; i++)
+            cache.store({ i, 0x1000 }, i * 31, i);
+
+        REQUIRE(cache.size() == 5000);
+
+        for (std::uint64_t i = 1; i <= 5000; i++)
+            REQUIRE(cache.lookup({ i, 0x1000 }, i * 31) == i);
+    }
+
+    SECTION("VersionMismatch")
+    {
+        {
+            SignatureCache cache(file.path);
+            cache.store(module.identity(), key, 0x10);
+        }
+
+        // a header from another version clears the file instead of reading garbage from it
+        {
+            std::fstream stream(file.path, std::ios::in | std::ios::out | std::ios::binary);
+            const auto version = SignatureCache::version + 1;
+            stream.seekp(offsetof(SignatureCache::Header, version));
+            stream.write(reinterpret_cast<const char*>(&version), sizeof(version));
+        }
+
+        SignatureCache cache(file.path);
+        REQUIRE(cache.size() == 0);
+        REQUIRE(!cache.lookup(module.identity(), key));
+    }
+
+    SECTION("CountMismatch")
+    {
+        {
+            SignatureCache cache(file.path);
+            cache.store(module.identity(), key, 0x10);
+        }
+
+        // a count lower than the entries in the table, as a crash between writing an entry and the count would leave it
+        {
+            std::fstream stream(file.path, std::ios::in | std::ios::out | std::ios::binary);
+            const std::uint64_t count = 0;
+            stream.seekp(offsetof(SignatureCache::Header, count));
+            stream.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        }
+
+        SignatureCache cache(file.path);
+        REQUIRE(cache.size() == 0);
+        REQUIRE(!cache.lookup(module.identity(), key));
+    }
+}
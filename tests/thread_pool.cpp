@@ -0,0 +1,59 @@
+#include <gensokyo.hpp>
+#include <catch2/catch_all.hpp>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST_CASE("ParallelFor", "ThreadPool")
+{
+    SECTION("EveryIndexOnce")
+    {
+        std::vector<std::atomic<int>> calls(1000);
+        gensokyo::thread_pool.parallel_for(calls.size(),
+                                           [&](std::size_t index)
+                                           {
+                                               calls[index]++;
+                                           });
+
+        for (const auto& count : calls)
+            REQUIRE(count == 1);
+    }
+
+    SECTION("Throws")
+    {
+        // thrown from every thread that gets a call, the others are still inside func when the first one throws
+        for (std::size_t thrower = 0; thrower < gensokyo::thread_pool.size() + 1; thrower++)
+        {
+            std::atomic<std::size_t> running {};
+            std::atomic<std::size_t> calls {};
+
+            REQUIRE_THROWS_AS(gensokyo::thread_pool.parallel_for(10000,
+                                                                 [&](std::size_t index)
+                                                                 {
+                                                                     running++;
+                                                                     calls++;
+                                                                     std::this_thread::sleep_for(std::chrono::microseconds(50));
+                                                                     running--;
+
+                                                                     if (index == thrower)
+                                                                         throw std::runtime_error("func failed");
+                                                                 }),
+                              std::runtime_error);
+
+            // nothing is left running with a dangling func, and the rest of the indices weren't handed out
+            REQUIRE(running == 0);
+            REQUIRE(calls < 10000);
+        }
+
+        std::atomic<std::size_t> calls {};
+        gensokyo::thread_pool.parallel_for(100,
+                                           [&](std::size_t)
+                                           {
+                                               calls++;
+                                           });
+
+        REQUIRE(calls == 100);
+    }
+}
@@ -0,0 +1,125 @@
+#include <gensokyo.hpp>
+#include <catch2/catch_all.hpp>
+#include "buffer_process.hpp"
+#include <array>
+#include <vector>
+
+TEST_CASE("ValueScanner", "Process")
+{
+    alignas(0x1000) static std::array<std::int32_t, 0x4400> memory {};
+    std::ranges::fill(memory, 7);
+
+    const auto base = reinterpret_cast<std::uintptr_t>(memory.data());
+    const auto slot = [&](std::size_t index)
+    {
+        return base + index * sizeof(std::int32_t);
+    };
+
+    BufferProcess process {};
+    process.mappings.push_back({ { base, 0x8000 }, true, true, false, false, "[heap]" });
+    process.mappings.push_back({ { base + 0x8000, 0x8000 }, true, false, false, true, "/usr/lib/libc.so.6" });
+    process.mappings.push_back({ { base + 0x10000, 0x1000 }, true, true, false, false, "" });
+
+    const std::vector<std::size_t> indexes { 0, 15, 16, 1000, 1023, 5000, 8191, 0x2000, 0x4000 - 1 };
+    for (const auto index : indexes)
+        memory[index] = 1234;
+
+    gensokyo::ValueScanner<std::int32_t> scanner(process);
+
+    SECTION("Narrowing")
+    {
+        // the last two are in the read only mapping
+        REQUIRE(scanner.first_scan(1234) == 7);
+        REQUIRE(scanner.results().front().address.ptr == slot(0));
+        REQUIRE(scanner.results().back().address.ptr == slot(8191));
+
+        memory[15]   = 1300;
+        memory[5000] = 1000;
+
+        REQUIRE(scanner.next_scan(gensokyo::ScanCompare::Increased) == 1);
+        REQUIRE(scanner.results().front().address.ptr == slot(15));
+        REQUIRE(scanner.results().front().value == 1300);
+
+        REQUIRE(scanner.next_scan(1234) == 0);
+    }
+
+    SECTION("Compare")
+    {
+        REQUIRE(scanner.first_scan(1234) == 7);
+
+        memory[16]   = 1000;
+        memory[1000] = 2000;
+        REQUIRE(scanner.next_scan(gensokyo::ScanCompare::Unchanged) == 5);
+        REQUIRE(scanner.next_scan(gensokyo::ScanCompare::Changed) == 0);
+
+        REQUIRE(scanner.first_scan(1234) == 5);
+        memory[0] = 0;
+        REQUIRE(scanner.next_scan(gensokyo::ScanCompare::Decreased) == 1);
+        REQUIRE(scanner.results(0).empty());
+    }
+
+    SECTION("Unknown")
+    {
+        // every slot of the writable mappings
+        REQUIRE(scanner.first_scan_unknown() == 0x9000 / sizeof(std::int32_t));
+
+        memory[1]    = 8;
+        memory[2000] = 9;
+        memory[3000] = 6;
+
+        // whole pages of candidates turn into listed slots here
+        REQUIRE(scanner.next_scan(gensokyo::ScanCompare::Changed) == 3);
+        REQUIRE(scanner.next_scan(gensokyo::ScanCompare::Increased) == 0);
+
+        REQUIRE(scanner.first_scan_unknown() == 0x2400);
+        memory[2000] = 10;
+        REQUIRE(scanner.next_scan(gensokyo::ScanCompare::Unchanged) == 0x2400 - 1);
+        REQUIRE(scanner.next_scan(9) == 0);
+    }
+
+    SECTION("DensePage")
+    {
+        std::fill_n(memory.begin() + 0x1400, 0x400, 1234);
+        REQUIRE(scanner.first_scan(1234) == 7 + 0x400);
+
+        for (std::size_t i = 0x1400; i < 0x1800; i += 2)
+            memory[i] = 0;
+
+        REQUIRE(scanner.next_scan(1234) == 7 + 0x200);
+
+        const auto results = scanner.results();
+        REQUIRE(std::ranges::is_sorted(results, {}, [](const auto& result) { return result.address.ptr; }));
+        REQUIRE(std::ranges::all_of(results, [](const auto& result) { return result.value == 1234; }));
+        REQUIRE(results[6].address.ptr == slot(0x1401));
+    }
+
+    SECTION("Unreadable")
+    {
+        REQUIRE(scanner.first_scan(1234) == 7);
+
+        // the page with slot 5000 goes away
+        process.bad_begin = slot(5000);
+        process.bad_end   = slot(5001);
+        REQUIRE(scanner.next_scan(gensokyo::ScanCompare::Unchanged) == 6);
+    }
+
+    SECTION("Types")
+    {
+        REQUIRE(gensokyo::ValueScanner<std::uint8_t>(process).first_scan(0xD2) == 7);
+
+        memory[20] = 0x11223344;
+        memory[21] = 0x55667788;
+        REQUIRE(gensokyo::ValueScanner<std::uint64_t>(process).first_scan(0x5566778811223344) == 1);
+        REQUIRE(gensokyo::ValueScanner<std::int16_t>(process).first_scan(0x5566) == 1);
+
+        auto* floats = reinterpret_cast<float*>(memory.data() + 0x4000);
+        floats[3]    = 1.004f;
+        floats[9]    = 0.996f;
+        floats[10]   = 1.02f;
+
+        gensokyo::ValueScanner<float> float_scanner(process, { .readable = true, .writable = true }, 0.005f);
+        REQUIRE(float_scanner.first_scan(1.0f) == 2);
+    }
+
+    REQUIRE(scanner.memory_usage() < 0x10000);
+}
@@ -0,0 +1,49 @@
+#include <gensokyo.hpp>
+#include <catch2/catch_all.hpp>
+#include "buffer_process.hpp"
+#include <array>
+
+TEST_CASE("WriteQueue", "Process")
+{
+    std::array<std::uint32_t, 0x400> values {};
+    const auto at = [&](std::size_t index)
+    {
+        return reinterpret_cast<std::uintptr_t>(&values[index]);
+    };
+
+    BufferProcess process {};
+    gensokyo::WriteQueue queue(process);
+
+    // three that touch, one that overlaps them, one far away and one to the same bytes again
+    queue.write<std::uint32_t>(at(2), 2);
+    queue.write<std::uint32_t>(at(0), 1);
+    queue.write<std::uint32_t>(at(1), 0xAAAAAAAA);
+    queue.write<std::uint16_t>(at(1) + 2, 0xBBBB);
+    queue.write<std::uint32_t>(at(0x200), 3);
+    queue.write<std::uint32_t>(at(2), 4);
+    REQUIRE(queue.size() == 6);
+
+    REQUIRE(queue.flush() == 6);
+    REQUIRE(queue.empty());
+    REQUIRE(process.writes == 2);
+    REQUIRE(values[0] == 1);
+    REQUIRE(values[1] == 0xBBBBAAAA);
+    REQUIRE(values[2] == 4);
+    REQUIRE(values[0x200] == 3);
+
+    SECTION("FailedWrite")
+    {
+        process.bad_begin = at(0x11);
+        process.bad_end   = at(0x11) + 1;
+        process.writes    = 0;
+
+        // the merged write fails, then each is written on its own
+        queue.write<std::uint32_t>(at(0x10), 5);
+        queue.write<std::uint32_t>(at(0x11), 6);
+        queue.write<std::uint32_t>(at(0x12), 7);
+
+        REQUIRE(queue.flush() == 2);
+        REQUIRE(process.writes == 4);
+        REQUIRE((values[0x10] == 5 && values[0x11] == 0 && values[0x12] == 7));
+    }
+}